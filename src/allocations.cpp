@@ -0,0 +1,118 @@
+#include "allocations.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+std::atomic<bool> tracking_enabled = false;
+std::atomic<size_t> allocation_count = 0;
+std::atomic<size_t> free_count = 0;
+std::atomic<size_t> bytes_allocated = 0;
+std::atomic<long> live_bytes = 0;
+std::atomic<long> peak_live_bytes = 0;
+
+size_t get_usable_size(void* ptr) {
+#if defined(__APPLE__)
+    return malloc_size(ptr);
+#else
+    return malloc_usable_size(ptr);
+#endif
+}
+
+void record_allocation(void* ptr, size_t size) {
+    if (!tracking_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+
+    long usable_size = get_usable_size(ptr);
+    long live = live_bytes.fetch_add(usable_size, std::memory_order_relaxed) + usable_size;
+    long peak = peak_live_bytes.load(std::memory_order_relaxed);
+
+    while (live > peak && !peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void record_free(void* ptr) {
+    if (ptr == nullptr || !tracking_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    free_count.fetch_add(1, std::memory_order_relaxed);
+    live_bytes.fetch_sub(get_usable_size(ptr), std::memory_order_relaxed);
+}
+
+void start_allocation_tracking() {
+    allocation_count = 0;
+    free_count = 0;
+    bytes_allocated = 0;
+    live_bytes = 0;
+    peak_live_bytes = 0;
+    tracking_enabled = true;
+}
+
+AllocationStats stop_allocation_tracking() {
+    tracking_enabled = false;
+
+    return AllocationStats {
+        allocation_count,
+        free_count,
+        bytes_allocated,
+        (size_t) peak_live_bytes.load(),
+    };
+}
+
+// Replacements for the global allocation functions. We only need to replace the
+// basic (unaligned and aligned) forms, plus the sized deletes (which compilers
+// expect to be replaced together with the unsized ones); the default implement-
+// ations of the array and nothrow forms are specified to forward to these.
+
+void* operator new(size_t size) {
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    record_allocation(ptr, size);
+    return ptr;
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    size_t align = std::max(sizeof(void*), static_cast<size_t>(alignment));
+    void* ptr = nullptr;
+
+    if (posix_memalign(&ptr, align, size == 0 ? 1 : size) != 0) {
+        throw std::bad_alloc();
+    }
+
+    record_allocation(ptr, size);
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    record_free(ptr);
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    record_free(ptr);
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept {
+    operator delete(ptr, alignment);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+// Heap allocation statistics, collected by the replacement global operator new and
+// operator delete in 'allocations.cpp'. Counting only happens between calls to
+// `start_allocation_tracking()` and `stop_allocation_tracking()`; outside of
+// those, the replacements cost one relaxed atomic load per call.
+//
+// Live bytes are relative to the start of tracking, so memory allocated before
+// tracking started and freed during tracking makes the live count go down. The
+// byte counts for live memory are based on the usable size of each block as
+// reported by the C allocator, since unsized deletes do not pass the size.
+
+struct AllocationStats {
+    size_t allocations;
+    size_t frees;
+    size_t bytes_allocated;
+    size_t peak_live_bytes;
+};
+
+void start_allocation_tracking();
+
+AllocationStats stop_allocation_tracking();
@@ -0,0 +1,97 @@
+#include "batch.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <print>
+#include <string>
+#include <vector>
+
+#include <glob.h>
+
+#include "input.hpp"
+#include "solution.hpp"
+#include "solve_context.hpp"
+#include "statistics.hpp"
+#include "thread_pool.hpp"
+
+std::vector<std::string> expand_input_pattern(const std::string& pattern) {
+    glob_t matches {};
+    int result = glob(pattern.c_str(), 0, nullptr, &matches);
+    assert((result == 0 || result == GLOB_NOMATCH) && "failed to expand input pattern");
+    std::vector<std::string> filenames;
+
+    for (size_t index = 0; index < matches.gl_pathc; ++index) {
+        if (std::filesystem::is_regular_file(matches.gl_pathv[index])) {
+            filenames.push_back(matches.gl_pathv[index]);
+        }
+    }
+
+    globfree(&matches);
+    std::ranges::sort(filenames);
+    return filenames;
+}
+
+// Every task writes only to the entries of its own inputs, so the results need
+// no locking. With a grain size of one, the inputs are split into a few chunks
+// per thread, which keeps the load balanced when input sizes vary. Each input
+// is solved in a serial scope, so that solutions which use the pool themselves
+// run on a single thread here; otherwise, a thread waiting for the tasks of one
+// input would run tasks (or whole chunks) of other inputs in the meantime, and
+// their solve times would be included in the latency of the waiting input.
+
+BatchResult run_batch(const Solver& solve, const std::vector<std::string>& filenames) {
+    BatchResult result { std::vector<BatchInput>(filenames.size()), 0.0 };
+    auto start_time = std::chrono::steady_clock::now();
+
+    parallel_for(0, filenames.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; ++index) {
+            SerialScope serial_scope;
+            const std::string& filename = filenames[index];
+            std::string input_name = std::filesystem::path(filename).stem().string();
+            auto input_start_time = std::chrono::steady_clock::now();
+
+            InputFile input_file(filename);
+            SolveContext context;
+            auto solution = solve(input_file.lines, input_name, context);
+
+            auto input_end_time = std::chrono::steady_clock::now();
+            double latency_us = std::chrono::duration<double, std::micro>(input_end_time - input_start_time).count();
+            result.inputs[index] = BatchInput { filename, input_file.size, latency_us, stringify(solution) };
+        }
+    });
+
+    auto end_time = std::chrono::steady_clock::now();
+    result.duration_us = std::chrono::duration<double, std::micro>(end_time - start_time).count();
+    return result;
+}
+
+void print_batch_result(const BatchResult& result) {
+    size_t total_bytes = 0;
+    std::vector<double> sorted_us;
+
+    for (const BatchInput& input : result.inputs) {
+        total_bytes += input.size;
+        sorted_us.push_back(input.latency_us);
+    }
+
+    std::ranges::sort(sorted_us);
+    double duration_s = result.duration_us / 1000000.0;
+
+    std::println("Inputs:     {} ({} bytes)", result.inputs.size(), total_bytes);
+    std::println("Wall time:  {:10.2f} ms", result.duration_us / 1000.0);
+    std::println("Throughput: {:10.1f} inputs/s ({:.2f} MB/s)", (double) result.inputs.size() / duration_s,
+        (double) total_bytes / result.duration_us);
+    std::println("");
+    std::println("Latency per input (load + solve):");
+    std::println("Min:        {:10.2f} μs", sorted_us.front());
+    std::println("Median:     {:10.2f} μs", percentile(sorted_us, 0.5));
+    std::println("P90:        {:10.2f} μs", percentile(sorted_us, 0.9));
+    std::println("P99:        {:10.2f} μs", percentile(sorted_us, 0.99));
+    std::println("Max:        {:10.2f} μs", sorted_us.back());
+
+    auto slowest = std::ranges::max_element(result.inputs, {}, &BatchInput::latency_us);
+    std::println("Slowest:    {} ({})", slowest->filename, slowest->solution);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "solution.hpp"
+
+// Batch mode: run one solution over many input files in a single process, as in
+// production, where the same solver processes thousands of inputs. The input files
+// are selected by a glob pattern (e.g. 'data/08/scaled_*.txt'), and are processed
+// concurrently on the shared thread pool (see 'thread_pool.hpp'), one input per
+// task, so that the concurrency is set by '--threads'. Every input is loaded,
+// split into lines and solved with a fresh solve context by the task that picks
+// it up, and its latency covers all of these steps. Parallel solutions run on a
+// single thread within a task (see `SerialScope`), since the pool is already
+// busy with other inputs, and a nested call would otherwise run their tasks
+// while it waits, adding their solve times to the latency of its own input.
+//
+// Solutions receive the stem of the input file (e.g. 'scaled_100') as the input
+// name. The batch mode runs with the binary input cache disabled, since cache
+// files are named after that stem only, so the latency includes parsing.
+
+// Result of solving a single input of a batch.
+
+struct BatchInput {
+    std::string filename;
+    size_t size;
+    double latency_us;
+    std::string solution;
+};
+
+// Results of a batch: the inputs in the order of their filenames, and the wall
+// time of the whole batch (in microseconds).
+
+struct BatchResult {
+    std::vector<BatchInput> inputs;
+    double duration_us;
+};
+
+// Expand a glob pattern into the sorted list of matching regular files.
+
+std::vector<std::string> expand_input_pattern(const std::string& pattern);
+
+BatchResult run_batch(const Solver& solve, const std::vector<std::string>& filenames);
+
+// Print the throughput of a batch in inputs per second and MB/s, and percentiles
+// of the per-input latency.
+
+void print_batch_result(const BatchResult& result);
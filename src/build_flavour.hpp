@@ -0,0 +1,9 @@
+#pragma once
+
+// Name of the build flavour that produced this binary (e.g. 'release' or 'pgo'),
+// passed in by the Makefile, so that profile output can be traced back to the
+// compiler flags that produced it.
+
+#ifndef BUILD_FLAVOUR
+#define BUILD_FLAVOUR "unknown"
+#endif
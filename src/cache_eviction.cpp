@@ -0,0 +1,73 @@
+#include "cache_eviction.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+// Size of a cache line; sweeping one byte per line touches every line.
+const size_t EVICTION_STRIDE = 64;
+
+// Parse a cache size as listed in sysfs, e.g. '32K' or '8192K'.
+
+size_t parse_cache_size(const std::string& text) {
+    size_t size = std::stoul(text);
+
+    if (text.ends_with("K")) {
+        return size * 1024;
+    } else if (text.ends_with("M")) {
+        return size * 1024 * 1024;
+    }
+
+    return size;
+}
+
+// On Linux, every cache level of a CPU has its own directory in sysfs; we take
+// the largest cache of the first CPU. On macOS, we ask for the L3 cache first,
+// and fall back to the L2 cache, which is the last level on Apple silicon.
+
+size_t get_last_level_cache_size() {
+    size_t largest_size = 0;
+
+#if defined(__APPLE__)
+    for (const char* name : { "hw.l3cachesize", "hw.l2cachesize" }) {
+        int64_t size = 0;
+        size_t length = sizeof(size);
+
+        if (sysctlbyname(name, &size, &length, nullptr, 0) == 0 && size > 0) {
+            largest_size = (size_t) size;
+            break;
+        }
+    }
+#else
+    std::error_code error;
+
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/cpu/cpu0/cache", error)) {
+        std::ifstream size_file(entry.path() / "size");
+        std::string text;
+
+        if (size_file >> text) {
+            largest_size = std::max(largest_size, parse_cache_size(text));
+        }
+    }
+#endif
+
+    return (largest_size > 0) ? largest_size : DEFAULT_LAST_LEVEL_CACHE_SIZE;
+}
+
+void evict_cpu_caches() {
+    static std::vector<unsigned char> buffer = std::vector<unsigned char>(get_last_level_cache_size() * EVICTION_BUFFER_FACTOR);
+
+    // Incrementing the bytes (rather than just reading them) forces every line
+    // into the cache in the modified state, and cannot be optimized away.
+    for (size_t index = 0; index < buffer.size(); index += EVICTION_STRIDE) {
+        buffer[index]++;
+    }
+}
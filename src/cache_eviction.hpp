@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+// Size of the last-level cache to assume when it cannot be determined.
+const size_t DEFAULT_LAST_LEVEL_CACHE_SIZE = 32 * 1024 * 1024;
+
+// Size of the eviction buffer relative to the last-level cache. Caches are not
+// strictly LRU, so sweeping a buffer of exactly the cache size does not evict
+// everything; twice the size evicts practically all lines in practice.
+const size_t EVICTION_BUFFER_FACTOR = 2;
+
+// Size of the largest (i.e. last-level) CPU cache in bytes, as reported by the
+// operating system, or the default size above if it does not report one.
+
+size_t get_last_level_cache_size();
+
+// Evict the CPU caches by writing to every cache line of a buffer larger than
+// the last-level cache, so that the next run starts without any of its data in
+// the caches. Dirty lines of the previous run are written back during the sweep
+// rather than during the next run. The buffer is allocated (and faulted in) on
+// the first call only. Only the caches shared with the calling thread (i.e. the
+// last-level cache, plus the private caches of the calling core) are evicted.
+
+void evict_cpu_caches();
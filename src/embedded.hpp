@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "solution.hpp"
+
+// Compile-time solving of embedded inputs. When building with `EMBED=1`, the
+// Makefile generates a header per supported day ('build/embedded/input_DD.hpp'),
+// which defines the contents of 'data/DD/input.txt' as a constexpr string view
+// named `EMBEDDED_INPUT` in the namespace of that day, and compiles with the
+// `EMBED_INPUTS` macro defined. Solutions whose logic is constexpr-capable can
+// then solve the embedded input during compilation, and register the result
+// using `REGISTER_EMBEDDED_SOLUTION()`. This replaces the regular solver for
+// the 'input' input name, so that e.g. `make profile 01a input EMBED=1` only
+// measures the cost of returning a constant; other inputs are still solved
+// at runtime. The cost moves to the compiler instead, which is limited in the
+// number of evaluation steps it is willing to take (see the Makefile).
+
+// Input name of the embedded inputs.
+const std::string EMBEDDED_INPUT_NAME = "input";
+
+// Split an embedded input into lines, with the same semantics as `split_lines()`
+// (see 'input.hpp'), but usable in constant expressions.
+
+constexpr std::vector<std::string_view> split_embedded_lines(std::string_view input) {
+    std::vector<std::string_view> lines;
+    size_t position = 0;
+
+    while (position < input.size()) {
+        size_t newline = input.find('\n', position);
+        size_t line_end = (newline != std::string_view::npos) ? newline : input.size();
+        lines.push_back(input.substr(position, line_end - position));
+        position = line_end + 1;
+    }
+
+    return lines;
+}
+
+// Solve an embedded input using a streaming solution (see 'solution.hpp'), which
+// must implement `consume()` and `finish()` as constexpr member functions.
+
+template <typename State>
+constexpr Solution solve_embedded(std::string_view input) {
+    std::vector<std::string_view> lines = split_embedded_lines(input);
+    State state {};
+    state.consume(std::span<const std::string_view>(lines));
+    return state.finish();
+}
+
+// Solutions of the embedded inputs, keyed by day and part (e.g. "01a").
+
+inline std::map<std::string, Solution>& get_embedded_solutions() {
+    static std::map<std::string, Solution> solutions;
+    return solutions;
+}
+
+// Replaces the regular solver of the given day and part, which must have been
+// registered before (i.e. earlier in the same file), by one that returns the
+// embedded solution for the embedded input, and calls the regular solver for
+// any other input.
+
+struct EmbeddedSolutionRegistrar {
+    EmbeddedSolutionRegistrar(const std::string& day_part, const Solution& solution) {
+        Solver solve = get_solutions().at(day_part);
+
+        get_solutions()[day_part] = [solve, solution](const auto& lines, const auto& input_name, SolveContext& context) {
+            return (input_name == EMBEDDED_INPUT_NAME) ? solution : solve(lines, input_name, context);
+        };
+
+        get_embedded_solutions()[day_part] = solution;
+    }
+};
+
+// The solution is assigned to a constexpr variable first, which forces it to be
+// evaluated at compile time; compilation fails if that is not possible.
+
+#define REGISTER_EMBEDDED_SOLUTION(day_part, solution) \
+    static constexpr Solution embedded_solution = solution; \
+    static const EmbeddedSolutionRegistrar embedded_solution_registrar { day_part, embedded_solution }
@@ -0,0 +1,245 @@
+#include "end_to_end.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <print>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "input.hpp"
+#include "solution.hpp"
+#include "solve_context.hpp"
+#include "statistics.hpp"
+#include "stream.hpp"
+#include "trace.hpp"
+
+extern char** environ;
+
+// Number of digits reserved for the exec timestamp in the environment of the child.
+const size_t TIMESTAMP_DIGITS = 20;
+
+// Sum the durations of the 'parse' trace events recorded on the calling thread.
+// Events of other threads overlap with those of the calling thread, so adding
+// them would count the same wall time more than once.
+
+int64_t get_parse_ns(const std::vector<TraceEvent>& events) {
+    int64_t parse_ns = 0;
+
+    for (const TraceEvent& event : events) {
+        if (std::strcmp(event.name, "parse") == 0 && event.thread_index == get_trace_thread_index()) {
+            parse_ns += event.duration_ns;
+        }
+    }
+
+    return parse_ns;
+}
+
+void run_end_to_end_child(const Solver& solve, const std::string& filename, const std::string& input_name, int64_t main_ns) {
+    const char* exec_timestamp = std::getenv(EXEC_TIMESTAMP_VARIABLE);
+    int64_t exec_ns = (exec_timestamp != nullptr) ? std::stoll(exec_timestamp) : main_ns;
+    int64_t load_ns = trace_now_ns();
+
+    InputTimings timings {};
+    InputFile input_file(filename, &timings);
+
+    int64_t split_end_ns = trace_now_ns();
+    int64_t read_end_ns = split_end_ns - (int64_t) (timings.split_us * 1000.0);
+    SolveContext context;
+    set_tracing_enabled(true);
+
+    auto solution = solve(input_file.lines, input_name, context);
+
+    int64_t solve_end_ns = trace_now_ns();
+    set_tracing_enabled(false);
+    int64_t parse_ns = get_parse_ns(take_trace_events());
+
+    std::println("e2e {} {} {} {} {} {} {} {}",
+        exec_ns, main_ns, load_ns, read_end_ns, split_end_ns, solve_end_ns, parse_ns, stringify(solution));
+}
+
+// Parse the line printed by the child, i.e. the tag, the timestamps, and the
+// solution (which is the remainder of the line).
+
+EndToEndRun parse_child_output(const std::string& output) {
+    size_t line_start = output.rfind("e2e ");
+    assert(line_start != std::string::npos && "end-to-end child did not report its timings");
+    std::string_view line = std::string_view(output).substr(line_start);
+
+    if (line.ends_with('\n')) {
+        line.remove_suffix(1);
+    }
+
+    std::vector<int64_t> values;
+    size_t position = line.find(' ') + 1;
+
+    while (values.size() < 7) {
+        size_t end = line.find(' ', position);
+        values.push_back(std::stoll(std::string(line.substr(position, end - position))));
+        position = end + 1;
+    }
+
+    EndToEndRun run {};
+    run.exec_ns = values[0];
+    run.main_ns = values[1];
+    run.load_ns = values[2];
+    run.read_end_ns = values[3];
+    run.split_end_ns = values[4];
+    run.solve_end_ns = values[5];
+    run.parse_ns = values[6];
+    run.solution = std::string(line.substr(position));
+    return run;
+}
+
+// Everything the child needs is prepared before forking: the parent may run
+// other threads (e.g. those of the thread pool), in which case the child may
+// only call async-signal-safe functions until it calls exec, so it must not
+// allocate. It only writes the digits of the exec timestamp into the entry
+// that is reserved for it in the environment.
+
+EndToEndRun run_end_to_end(
+    const std::string& program,
+    const std::vector<std::string>& arguments,
+    const std::string& filename,
+    bool evict_page_cache
+) {
+    if (evict_page_cache) {
+        evict_file_cache(filename);
+    }
+
+    std::vector<std::string> argument_strings = { program };
+    argument_strings.insert(argument_strings.end(), arguments.begin(), arguments.end());
+    std::vector<char*> argv;
+
+    for (std::string& argument : argument_strings) {
+        argv.push_back(argument.data());
+    }
+
+    argv.push_back(nullptr);
+
+    std::string prefix = std::string(EXEC_TIMESTAMP_VARIABLE) + "=";
+    std::string timestamp_entry = prefix + std::string(TIMESTAMP_DIGITS, '0');
+    std::vector<char*> envp;
+
+    for (char** entry = environ; *entry != nullptr; ++entry) {
+        if (!std::string_view(*entry).starts_with(prefix)) {
+            envp.push_back(*entry);
+        }
+    }
+
+    envp.push_back(timestamp_entry.data());
+    envp.push_back(nullptr);
+    char* digits = timestamp_entry.data() + prefix.size();
+
+    int pipe_fds[2];
+    int result = pipe(pipe_fds);
+    assert(result == 0);
+
+    EndToEndRun run {};
+    run.fork_ns = trace_now_ns();
+    pid_t pid = fork();
+    assert(pid != -1);
+
+    if (pid == 0) {
+        dup2(pipe_fds[1], STDOUT_FILENO);
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+
+        int64_t exec_ns = trace_now_ns();
+
+        for (size_t index = TIMESTAMP_DIGITS; index > 0; --index) {
+            digits[index - 1] = (char) ('0' + exec_ns % 10);
+            exec_ns /= 10;
+        }
+
+        execve(argv[0], argv.data(), envp.data());
+        _exit(127);
+    }
+
+    close(pipe_fds[1]);
+    std::string output;
+    char buffer[4096];
+    ssize_t count = 0;
+
+    while ((count = read(pipe_fds[0], buffer, sizeof(buffer))) > 0) {
+        output.append(buffer, count);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    int64_t exit_ns = trace_now_ns();
+    close(pipe_fds[0]);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0 && "end-to-end child failed");
+
+    int64_t fork_ns = run.fork_ns;
+    run = parse_child_output(output);
+    run.fork_ns = fork_ns;
+    run.exit_ns = exit_ns;
+    return run;
+}
+
+// A step of an end-to-end run, and how to get its duration (in ns) from a run.
+
+struct EndToEndStep {
+    const char* name;
+    std::function<int64_t(const EndToEndRun&)> get_duration_ns;
+};
+
+const std::vector<EndToEndStep> END_TO_END_STEPS = {
+    { "Fork",         [](const EndToEndRun& run) { return run.exec_ns - run.fork_ns; } },
+    { "Exec to main", [](const EndToEndRun& run) { return run.main_ns - run.exec_ns; } },
+    { "Setup",        [](const EndToEndRun& run) { return run.load_ns - run.main_ns; } },
+    { "Open/read",    [](const EndToEndRun& run) { return run.read_end_ns - run.load_ns; } },
+    { "Split",        [](const EndToEndRun& run) { return run.split_end_ns - run.read_end_ns; } },
+    { "Parse",        [](const EndToEndRun& run) { return run.parse_ns; } },
+    { "Solve",        [](const EndToEndRun& run) { return run.solve_end_ns - run.split_end_ns - run.parse_ns; } },
+    { "Exit",         [](const EndToEndRun& run) { return run.exit_ns - run.solve_end_ns; } },
+    { "Total",        [](const EndToEndRun& run) { return run.exit_ns - run.fork_ns; } },
+};
+
+void print_end_to_end_runs(const std::vector<EndToEndRun>& runs) {
+    auto get_sorted_us = [&](const EndToEndStep& step) {
+        std::vector<double> samples_us;
+
+        for (const EndToEndRun& run : runs) {
+            samples_us.push_back((double) step.get_duration_ns(run) / 1000.0);
+        }
+
+        std::ranges::sort(samples_us);
+        return samples_us;
+    };
+
+    bool has_parse = std::ranges::any_of(runs, [](const EndToEndRun& run) { return run.parse_ns > 0; });
+    double total_us = percentile(get_sorted_us(END_TO_END_STEPS.back()), 0.5);
+
+    std::println("Solution: {}", runs.front().solution);
+    std::println("Runs:     {}", runs.size());
+    std::println("");
+    std::println("{:<14} {:>12} {:>12} {:>8}", "(μs)", "Median", "Min", "Share");
+
+    for (const EndToEndStep& step : END_TO_END_STEPS) {
+        if (!has_parse && std::strcmp(step.name, "Parse") == 0) {
+            continue;
+        }
+
+        std::vector<double> sorted_us = get_sorted_us(step);
+        double median = percentile(sorted_us, 0.5);
+        std::println("{:<14} {:>12.2f} {:>12.2f} {:>7.1f}%", step.name, median, sorted_us.front(), 100.0 * median / total_us);
+    }
+
+    if (!has_parse && TRACE_SCOPES_COMPILED) {
+        std::println("No parse phases traced by this solution; parsing is included in the solve time");
+    } else if (!has_parse) {
+        std::println("No parse phases traced; parsing is included in the solve time (build with TRACE=1 to separate them)");
+    }
+
+    std::println("Input cache: off in the child processes (every run parses its input)");
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "solution.hpp"
+
+// End-to-end timing of a solution, as experienced by a user running the binary:
+// the parent process forks and executes a child process for every run, which
+// loads the input, solves it once, and reports the time at which it reached
+// each step, so that the wall time of the run can be broken down into:
+// - Fork: from the fork until the child calls exec.
+// - Exec to main: loading the binary and its libraries, and static initialization
+//   (e.g. registering all solutions), until the child enters `main()`.
+// - Setup: parsing the arguments, and starting the thread pool if its size is set.
+// - Open/read: opening and mapping the input file, and reading all of its pages.
+// - Split: splitting the input into lines.
+// - Parse: the part of the solve time spent in trace scopes named 'parse', which
+//   is only recorded when tracing is compiled in (TRACE=1). The child runs without
+//   the binary input cache, so that solutions which cache their parsed input
+//   still parse it in every run.
+// - Solve: the rest of the solve time.
+// - Exit: printing the results, tearing down the child process, and waking up
+//   the parent.
+// The child receives the time just before exec in an environment variable, and
+// all timestamps are taken from the steady clock, which is shared by processes.
+
+// Environment variable with the steady clock time (in ns) just before exec.
+const char* const EXEC_TIMESTAMP_VARIABLE = "AOC_EXEC_TIMESTAMP_NS";
+
+// Steady clock timestamps (in ns) of a single end-to-end run, and the time spent
+// parsing (in ns), as reported by the child process.
+
+struct EndToEndRun {
+    std::string solution;
+    int64_t fork_ns;
+    int64_t exec_ns;
+    int64_t main_ns;
+    int64_t load_ns;
+    int64_t read_end_ns;
+    int64_t split_end_ns;
+    int64_t solve_end_ns;
+    int64_t exit_ns;
+    int64_t parse_ns;
+};
+
+// Child side: load the input, solve it once, and print the timestamps to stdout.
+// `main_ns` is the time at which `main()` was entered.
+
+void run_end_to_end_child(const Solver& solve, const std::string& filename, const std::string& input_name, int64_t main_ns);
+
+// Parent side: execute `program` with the given arguments (which must select the
+// child side of the end-to-end mode), optionally after dropping the input file
+// from the page cache, and collect the timestamps reported by the child.
+
+EndToEndRun run_end_to_end(
+    const std::string& program,
+    const std::vector<std::string>& arguments,
+    const std::string& filename,
+    bool evict_page_cache
+);
+
+// Print the median and minimum duration of every step over all runs, and their
+// share of the median total.
+
+void print_end_to_end_runs(const std::vector<EndToEndRun>& runs);
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Deterministic source of random numbers for input generators. We only use the
+// raw output of the 64-bit Mersenne Twister, whose sequence is fully specified
+// by the standard, and not the standard distributions or `std::shuffle()`, whose
+// results are implementation-defined. This way, the same seed produces the same
+// input files on every platform and with every standard library.
+
+struct Random {
+    std::mt19937_64 engine;
+
+    Random(uint64_t seed, uint64_t stream) : engine(seed ^ (stream * 0x9e3779b97f4a7c15)) {}
+
+    // Random integer in the range [low, high], both inclusive. The modulo bias is
+    // negligible for the ranges used by the generators.
+    long between(long low, long high) {
+        return low + (long) (engine() % (uint64_t) (high - low + 1));
+    }
+
+    // Random double in the range [0, 1).
+    double uniform() {
+        return (double) (engine() >> 11) * 0x1.0p-53;
+    }
+
+    bool chance(double probability) {
+        return uniform() < probability;
+    }
+
+    template <typename T>
+    void shuffle(std::vector<T>& values) {
+        for (size_t index = values.size(); index > 1; --index) {
+            std::swap(values[index - 1], values[between(0, index - 1)]);
+        }
+    }
+};
+
+// Signature of an input generator, implemented per day in 'generate.cpp'. The
+// generator writes a synthetic input with the same format and the same struc-
+// tural guarantees as the real puzzle input, but `scale` times as large (for
+// some suitable definition of size, e.g. the number of lines). It returns
+// false if the puzzle format cannot represent an input of this scale.
+
+typedef bool (*GenerateFunction)(std::ostream& output, size_t scale, Random& random);
+
+// Registry of all generators linked into the binary, keyed by day (e.g. "08");
+// see `get_solutions()` in 'solution.hpp'.
+
+inline std::map<std::string, GenerateFunction>& get_generators() {
+    static std::map<std::string, GenerateFunction> generators;
+    return generators;
+}
+
+struct GeneratorRegistrar {
+    GeneratorRegistrar(const std::string& day, GenerateFunction generate) {
+        get_generators()[day] = generate;
+    }
+};
+
+#define REGISTER_GENERATOR(day, generate) \
+    static const GeneratorRegistrar generator_registrar { day, generate }
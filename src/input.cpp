@@ -0,0 +1,221 @@
+#include "input.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "thread_pool.hpp"
+
+// Minimum size of a chunk when splitting lines in parallel.
+const size_t SPLIT_CHUNK_SIZE = 1024 * 1024;
+
+std::string get_input_filename(const std::string& day_part, const std::string& input_name) {
+    return "data/" + day_part.substr(0, 2) + "/" + input_name + ".txt";
+}
+
+InputFile::InputFile(const std::string& filename) : InputFile(filename, nullptr) {}
+
+// Map the file into memory and build the line index. Empty files cannot be
+// mapped, so these are represented by a null pointer and an empty index. When
+// timings are requested, we read one byte of every page before splitting, so
+// that all pages are faulted in (from the page cache, or from the disk) before
+// the split starts, and reading and splitting can be timed separately.
+
+InputFile::InputFile(const std::string& filename, InputTimings* timings) : data(nullptr), size(0) {
+    auto start_time = std::chrono::steady_clock::now();
+    int fd = open(filename.c_str(), O_RDONLY);
+    assert(fd != -1);
+
+    struct stat file_stat;
+    fstat(fd, &file_stat);
+    size = file_stat.st_size;
+
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        assert(mapping != MAP_FAILED);
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapping);
+    }
+
+    close(fd);
+
+    if (timings != nullptr) {
+        size_t page_size = sysconf(_SC_PAGESIZE);
+        unsigned char checksum = 0;
+
+        for (size_t offset = 0; offset < size; offset += page_size) {
+            checksum += (unsigned char) data[offset];
+        }
+
+        volatile unsigned char sink = checksum;
+        (void) sink;
+    }
+
+    auto read_time = std::chrono::steady_clock::now();
+    lines = (size >= PARALLEL_SPLIT_MIN_SIZE) ? split_lines_parallel(data, size) : split_lines(data, size);
+    auto end_time = std::chrono::steady_clock::now();
+
+    if (timings != nullptr) {
+        timings->read_us = std::chrono::duration<double, std::micro>(read_time - start_time).count();
+        timings->split_us = std::chrono::duration<double, std::micro>(end_time - read_time).count();
+    }
+}
+
+InputFile::~InputFile() {
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), size);
+    }
+}
+
+// Split a buffer into lines, using the same semantics as `std::getline()`: the
+// newline characters are not included, and a trailing newline at the end of the
+// buffer does not produce an additional empty line. We count the newlines first
+// so that the line index is allocated exactly once.
+
+std::vector<std::string_view> split_lines(const char* data, size_t size) {
+    std::vector<std::string_view> lines;
+
+    if (size == 0) {
+        return lines;
+    }
+
+    lines.reserve(std::count(data, data + size, '\n') + 1);
+
+    const char* position = data;
+    const char* end = data + size;
+
+    while (position < end) {
+        const char* newline = static_cast<const char*>(std::memchr(position, '\n', end - position));
+        const char* line_end = (newline != nullptr) ? newline : end;
+        lines.emplace_back(position, line_end - position);
+        position = line_end + 1;
+    }
+
+    return lines;
+}
+
+// Call `callback(newline)` for every newline in the range [begin, end), in order.
+// With AVX2, we compare blocks of 32 bytes against the newline character at once,
+// and iterate over the set bits of the resulting mask; otherwise, and for the tail
+// of the range, we fall back to `memchr()`, which is vectorized by the C library.
+
+template <typename Callback>
+void for_each_newline(const char* begin, const char* end, Callback&& callback) {
+    const char* position = begin;
+
+#ifdef __AVX2__
+    const __m256i newlines = _mm256_set1_epi8('\n');
+
+    for (; position + 32 <= end; position += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(position));
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newlines));
+
+        while (mask != 0) {
+            callback(position + std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    while (position < end) {
+        const char* newline = static_cast<const char*>(std::memchr(position, '\n', end - position));
+
+        if (newline == nullptr) {
+            return;
+        }
+
+        callback(newline);
+        position = newline + 1;
+    }
+}
+
+size_t count_newlines(const char* begin, const char* end) {
+    size_t count = 0;
+    for_each_newline(begin, end, [&count](const char*) { count++; });
+    return count;
+}
+
+// The backward searches in this file and in 'stream.cpp' stop at the first newline
+// they meet, which is usually only one line back, so a byte loop is fast enough.
+
+const char* find_last_newline(const char* data, size_t size) {
+    auto iter = std::find(std::make_reverse_iterator(data + size), std::make_reverse_iterator(data), '\n');
+    return (iter.base() != data) ? iter.base() - 1 : nullptr;
+}
+
+// Split a buffer into lines in parallel, with the same semantics as `split_lines()`.
+// Every line belongs to the chunk containing its newline. In a first parallel pass,
+// we count the newlines in every chunk; a prefix sum over these counts then gives
+// the index of the first line of every chunk, so that the line index can be
+// allocated once, and every chunk can write its own lines independently in the
+// second pass. The first line of a chunk usually starts in an earlier chunk; we
+// stitch it together by searching backward for the preceding newline. The last
+// line is added separately if the buffer does not end with a newline.
+
+std::vector<std::string_view> split_lines_parallel(const char* data, size_t size) {
+    std::vector<std::string_view> lines;
+
+    if (size == 0) {
+        return lines;
+    }
+
+    size_t chunk_count = std::clamp(size / SPLIT_CHUNK_SIZE, (size_t) 1, get_thread_pool().thread_count() * CHUNKS_PER_THREAD);
+    auto get_chunk_begin = [=](size_t chunk) { return data + (size * chunk) / chunk_count; };
+    std::vector<size_t> first_lines = std::vector<size_t>(chunk_count + 1, 0);
+
+    parallel_for(0, chunk_count, 1, [&](size_t chunk_begin, size_t chunk_end) {
+        for (size_t chunk = chunk_begin; chunk < chunk_end; ++chunk) {
+            first_lines[chunk + 1] = count_newlines(get_chunk_begin(chunk), get_chunk_begin(chunk + 1));
+        }
+    });
+
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        first_lines[chunk + 1] += first_lines[chunk];
+    }
+
+    bool has_last_line = data[size - 1] != '\n';
+    lines.resize(first_lines[chunk_count] + (has_last_line ? 1 : 0));
+
+    parallel_for(0, chunk_count, 1, [&](size_t chunk_begin, size_t chunk_end) {
+        for (size_t chunk = chunk_begin; chunk < chunk_end; ++chunk) {
+            if (first_lines[chunk + 1] == first_lines[chunk]) {
+                continue;
+            }
+
+            const char* begin = get_chunk_begin(chunk);
+            const char* previous = find_last_newline(data, begin - data);
+            const char* line_start = (previous != nullptr) ? previous + 1 : data;
+            size_t line_index = first_lines[chunk];
+
+            for_each_newline(begin, get_chunk_begin(chunk + 1), [&](const char* newline) {
+                lines[line_index++] = std::string_view(line_start, newline - line_start);
+                line_start = newline + 1;
+            });
+        }
+    });
+
+    if (has_last_line) {
+        const char* previous = find_last_newline(data, size);
+        const char* line_start = (previous != nullptr) ? previous + 1 : data;
+        lines.back() = std::string_view(line_start, data + size - line_start);
+    }
+
+    return lines;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Read-only view of an input file. The file is memory-mapped once, and the line
+// index consists of string views pointing directly into that mapping; loading an
+// input therefore costs one page-fault walk over the file instead of one heap
+// allocation and copy per line. The mapping is released on destruction, so the
+// line views must not outlive the `InputFile` object.
+
+// Time spent loading an input file, in microseconds: opening and mapping the
+// file plus reading all of its pages (`read_us`), and building the line index
+// (`split_us`). Without timings, pages are read lazily while splitting.
+
+struct InputTimings {
+    double read_us;
+    double split_us;
+};
+
+struct InputFile {
+    const char* data;
+    size_t size;
+    std::vector<std::string_view> lines;
+
+    explicit InputFile(const std::string& filename);
+    InputFile(const std::string& filename, InputTimings* timings);
+    ~InputFile();
+
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+};
+
+// Input file of the given day and part (or day) and input name, e.g. 'data/08/input.txt'.
+std::string get_input_filename(const std::string& day_part, const std::string& input_name);
+
+// Inputs of at least this size are split into lines in parallel.
+const size_t PARALLEL_SPLIT_MIN_SIZE = 4 * 1024 * 1024;
+
+std::vector<std::string_view> split_lines(const char* data, size_t size);
+
+std::vector<std::string_view> split_lines_parallel(const char* data, size_t size);
+
+// Find the last newline in the first `size` bytes of `data`, or return a null
+// pointer if there is none; a portable replacement for the GNU `memrchr()`.
+const char* find_last_newline(const char* data, size_t size);
@@ -0,0 +1,272 @@
+#include "input_cache.hpp"
+
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char CACHE_MAGIC[8] = { 'A', 'O', 'C', 'C', 'A', 'C', 'H', 'E' };
+
+const uint64_t HASH_SEED = 0x9E3779B97F4A7C15ull;
+const uint64_t HASH_PRIME = 0xC2B2AE3D27D4EB4Full;
+
+// Final avalanche step of MurmurHash3, so that every input bit affects every bit
+// of the hash.
+
+uint64_t mix_hash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    return hash ^ (hash >> 33);
+}
+
+// Hash the input 32 bytes at a time, in four independent lanes of eight bytes, so
+// that the multiplies of the lanes overlap instead of forming one dependency chain
+// per byte (as in FNV-1a). The remaining bytes are folded in one at a time. This
+// is not a cryptographic hash; it only has to detect changed inputs.
+
+uint64_t hash_content(const char* data, size_t size) {
+    uint64_t lanes[4] = { HASH_SEED, HASH_SEED + 1, HASH_SEED + 2, HASH_SEED + 3 };
+    size_t position = 0;
+
+    for (; position + 32 <= size; position += 32) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            uint64_t word;
+            std::memcpy(&word, data + position + lane * 8, 8);
+            lanes[lane] = std::rotl(lanes[lane] ^ word, 31) * HASH_PRIME;
+        }
+    }
+
+    uint64_t hash = size;
+
+    for (uint64_t lane : lanes) {
+        hash = (hash ^ mix_hash(lane)) * HASH_PRIME;
+    }
+
+    for (; position < size; ++position) {
+        hash = (hash ^ (uint8_t) data[position]) * HASH_PRIME;
+    }
+
+    return mix_hash(hash);
+}
+
+std::string get_cache_filename(const std::string& day, const std::string& input_name, const std::string& key) {
+    return "data/" + day + "/" + input_name + "." + key + ".cache";
+}
+
+CachedArrays::~CachedArrays() {
+    if (mapping != nullptr) {
+        munmap(const_cast<void*>(mapping), mapping_size);
+    }
+}
+
+size_t align_offset(size_t offset) {
+    return (offset + CACHE_ALIGNMENT - 1) / CACHE_ALIGNMENT * CACHE_ALIGNMENT;
+}
+
+// Map a cache file, and validate its header against the content hash and the
+// expected element sizes. Returns a null pointer if the file does not exist,
+// or if it does not match (e.g. because the input or the solution changed).
+
+std::unique_ptr<CachedArrays> map_cache_file(
+    const std::string& filename,
+    uint64_t content_hash,
+    const std::vector<size_t>& element_sizes
+) {
+    int fd = open(filename.c_str(), O_RDONLY);
+
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    struct stat file_stat;
+    fstat(fd, &file_stat);
+    size_t size = file_stat.st_size;
+    void* mapping = (size >= sizeof(CacheHeader)) ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    auto cached = std::make_unique<CachedArrays>();
+    cached->mapping = mapping;
+    cached->mapping_size = size;
+    cached->content_hash = content_hash;
+
+    const std::byte* data = static_cast<const std::byte*>(mapping);
+    const CacheHeader* header = reinterpret_cast<const CacheHeader*>(data);
+    size_t headers_end = sizeof(CacheHeader) + element_sizes.size() * sizeof(CacheArrayHeader);
+
+    bool is_valid = std::memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+        header->version == CACHE_VERSION &&
+        header->content_hash == content_hash &&
+        header->array_count == element_sizes.size() &&
+        size >= headers_end;
+
+    const CacheArrayHeader* array_headers = reinterpret_cast<const CacheArrayHeader*>(data + sizeof(CacheHeader));
+
+    for (size_t index = 0; is_valid && index < element_sizes.size(); ++index) {
+        const CacheArrayHeader& array_header = array_headers[index];
+        size_t array_size = array_header.element_size * array_header.count;
+        is_valid = array_header.element_size == element_sizes[index] && array_header.offset + array_size <= size;
+
+        if (is_valid) {
+            cached->arrays.emplace_back(data + array_header.offset, array_size);
+            cached->element_sizes.push_back(array_header.element_size);
+        }
+    }
+
+    return is_valid ? std::move(cached) : nullptr;
+}
+
+// Write all bytes of a buffer at the given offset, retrying short writes.
+
+bool write_fully(int fd, const void* data, size_t size, size_t offset) {
+    const char* bytes = static_cast<const char*>(data);
+
+    while (size > 0) {
+        ssize_t written = pwrite(fd, bytes, size, (off_t) offset);
+
+        if (written == -1 && errno == EINTR) {
+            continue;
+        } else if (written <= 0) {
+            return false;
+        }
+
+        bytes += written;
+        size -= (size_t) written;
+        offset += (size_t) written;
+    }
+
+    return true;
+}
+
+// Write the arrays of a builder to a cache file. The file is written to a unique
+// temporary file in the same directory (created by `mkstemp()`), and only renamed
+// into place once every write has succeeded. Concurrent writers of the same cache
+// file (e.g. two server connections, or two processes on a cold cache) therefore
+// each write their own file, and a reader only ever maps a complete file, which
+// is never truncated or rewritten under its mapping. Failure to write (e.g. in a
+// read-only data directory) is not an error; the arrays are then simply not cached.
+
+void write_cache_file(const std::string& filename, uint64_t content_hash, const CacheBuilder& builder) {
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.content_hash = content_hash;
+    header.array_count = builder.arrays.size();
+
+    std::vector<CacheArrayHeader> array_headers;
+    size_t offset = align_offset(sizeof(CacheHeader) + builder.arrays.size() * sizeof(CacheArrayHeader));
+
+    for (size_t index = 0; index < builder.arrays.size(); ++index) {
+        size_t element_size = builder.element_sizes[index];
+        array_headers.push_back(CacheArrayHeader { element_size, builder.arrays[index].size() / element_size, offset });
+        offset = align_offset(offset + builder.arrays[index].size());
+    }
+
+    std::string temporary_filename = filename + ".XXXXXX";
+    int fd = mkstemp(temporary_filename.data());
+
+    if (fd == -1) {
+        return;
+    }
+
+    bool is_written = write_fully(fd, &header, sizeof(header), 0) &&
+        write_fully(fd, array_headers.data(), array_headers.size() * sizeof(CacheArrayHeader), sizeof(header));
+
+    for (size_t index = 0; is_written && index < builder.arrays.size(); ++index) {
+        is_written = write_fully(fd, builder.arrays[index].data(), builder.arrays[index].size(), array_headers[index].offset);
+    }
+
+    // Extend the file to its aligned end, so that an empty last array (whose
+    // bytes are never written) still lies within the file.
+    is_written = is_written && ftruncate(fd, (off_t) offset) == 0;
+    is_written = (close(fd) == 0) && is_written;
+
+    if (!is_written || std::rename(temporary_filename.c_str(), filename.c_str()) != 0) {
+        std::remove(temporary_filename.c_str());
+    }
+}
+
+// Keep the arrays of a builder in memory, for when caching is disabled, or when
+// the cache file could not be written.
+
+std::unique_ptr<CachedArrays> keep_in_memory(CacheBuilder& builder, uint64_t content_hash) {
+    auto cached = std::make_unique<CachedArrays>();
+    cached->content_hash = content_hash;
+    cached->element_sizes = builder.element_sizes;
+    cached->storage = std::move(builder.arrays);
+
+    for (const std::vector<std::byte>& bytes : cached->storage) {
+        cached->arrays.emplace_back(bytes.data(), bytes.size());
+    }
+
+    return cached;
+}
+
+const CachedArrays& InputCache::load(
+    const std::string& filename,
+    const std::vector<std::string_view>& lines,
+    const std::vector<size_t>& element_sizes,
+    const CacheBuildFunction& build
+) {
+    if (!is_input_cache_enabled()) {
+        CacheBuilder builder;
+        build(builder);
+        return *(loaded[filename] = keep_in_memory(builder, 0));
+    }
+
+    uint64_t hash = get_content_hash(lines);
+    auto iter = loaded.find(filename);
+
+    if (iter != loaded.end() && iter->second->mapping != nullptr && iter->second->content_hash == hash) {
+        return *iter->second;
+    }
+
+    std::unique_ptr<CachedArrays> cached = map_cache_file(filename, hash, element_sizes);
+
+    if (cached == nullptr) {
+        CacheBuilder builder;
+        build(builder);
+        assert(builder.element_sizes == element_sizes && "built arrays do not match the element types");
+        write_cache_file(filename, hash, builder);
+        cached = map_cache_file(filename, hash, element_sizes);
+
+        if (cached == nullptr) {
+            cached = keep_in_memory(builder, hash);
+        }
+    }
+
+    return *(loaded[filename] = std::move(cached));
+}
+
+// The lines are views into a single input buffer, so we hash the contents of the
+// buffer from the start of the first line to the end of the last one. The hash
+// is only recomputed when the solution is called with a different buffer.
+
+uint64_t InputCache::get_content_hash(const std::vector<std::string_view>& lines) {
+    const char* data = lines.empty() ? nullptr : lines.front().data();
+    size_t size = lines.empty() ? 0 : (lines.back().data() + lines.back().size()) - data;
+
+    if (data != hashed_data || size != hashed_size || data == nullptr) {
+        hashed_data = data;
+        hashed_size = size;
+        content_hash = hash_content(data, size);
+    }
+
+    return content_hash;
+}
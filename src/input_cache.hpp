@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Binary cache of pre-parsed input structures. A solution that spends much of its
+// time parsing can store the result of parsing in a cache file next to its input
+// (e.g. 'data/08/input.points.cache'), as one or more arrays of trivially copyable
+// elements. Later runs map the cache file into memory and use the arrays in place,
+// without parsing the input at all.
+//
+// A cache file starts with a fixed header, containing a hash of the input contents
+// (see `hash_content()`), followed by one header per array, and the arrays themselves (each
+// aligned to a cache line). If the hash, format version, or element types do not
+// match, the cache file is rebuilt. Caching can be disabled with '--no-cache', in
+// which case the arrays are rebuilt in memory on every run.
+
+const uint64_t CACHE_VERSION = 2;
+const size_t CACHE_ALIGNMENT = 64;
+
+struct CacheHeader {
+    char magic[8];
+    uint64_t version;
+    uint64_t content_hash;
+    uint64_t array_count;
+};
+
+struct CacheArrayHeader {
+    uint64_t element_size;
+    uint64_t count;
+    uint64_t offset;
+};
+
+uint64_t hash_content(const char* data, size_t size);
+
+inline std::atomic<bool> input_cache_enabled = true;
+
+inline bool is_input_cache_enabled() {
+    return input_cache_enabled.load(std::memory_order_relaxed);
+}
+
+inline void set_input_cache_enabled(bool enabled) {
+    input_cache_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// Cache file for the given day, input name, and key of the cached structures.
+std::string get_cache_filename(const std::string& day, const std::string& input_name, const std::string& key);
+
+// Arrays of a cache file, either mapped from the file, or built in memory (in
+// which case `storage` owns their bytes). Arrays are accessed by their index
+// in the order in which they were added.
+
+struct CachedArrays {
+    uint64_t content_hash = 0;
+    std::vector<std::span<const std::byte>> arrays;
+    std::vector<size_t> element_sizes;
+    std::vector<std::vector<std::byte>> storage;
+    const void* mapping = nullptr;
+    size_t mapping_size = 0;
+
+    CachedArrays() = default;
+    ~CachedArrays();
+
+    CachedArrays(const CachedArrays&) = delete;
+    CachedArrays& operator=(const CachedArrays&) = delete;
+
+    template <typename T>
+    std::span<const T> get(size_t index) const {
+        assert(index < arrays.size() && element_sizes[index] == sizeof(T));
+        return std::span(reinterpret_cast<const T*>(arrays[index].data()), arrays[index].size() / sizeof(T));
+    }
+};
+
+// Collects the arrays of a new cache file when building it.
+
+struct CacheBuilder {
+    std::vector<std::vector<std::byte>> arrays;
+    std::vector<size_t> element_sizes;
+
+    template <typename T>
+    void add(std::span<const T> values) {
+        static_assert(std::is_trivially_copyable_v<T>, "cached elements must be trivially copyable");
+        std::vector<std::byte>& bytes = arrays.emplace_back(values.size_bytes());
+
+        if (!values.empty()) {
+            std::memcpy(bytes.data(), values.data(), values.size_bytes());
+        }
+
+        element_sizes.push_back(sizeof(T));
+    }
+};
+
+typedef std::function<void(CacheBuilder&)> CacheBuildFunction;
+
+// Cache of the solve context (see 'solve_context.hpp'). The hash of the input is
+// computed once per input buffer, and loaded arrays stay mapped for the lifetime
+// of the context, so repeated runs in profile mode only pay for a map lookup.
+
+struct InputCache {
+    std::map<std::string, std::unique_ptr<CachedArrays>> loaded;
+    const char* hashed_data = nullptr;
+    size_t hashed_size = 0;
+    uint64_t content_hash = 0;
+
+    // Return the arrays stored in the given cache file, which caches structures
+    // parsed from the given input lines, and has one array per element type. If
+    // the file does not exist or does not match the input, call `build()` to
+    // create the arrays, and write them to the file for later runs.
+    template <typename... T>
+    const CachedArrays& load(
+        const std::string& filename,
+        const std::vector<std::string_view>& lines,
+        const CacheBuildFunction& build
+    ) {
+        return load(filename, lines, { sizeof(T)... }, build);
+    }
+
+    const CachedArrays& load(
+        const std::string& filename,
+        const std::vector<std::string_view>& lines,
+        const std::vector<size_t>& element_sizes,
+        const CacheBuildFunction& build
+    );
+
+    uint64_t get_content_hash(const std::vector<std::string_view>& lines);
+
+    // Forget the hash of the last input buffer. Must be called when an input is
+    // reloaded, since the new mapping may reuse the address of the old one.
+    void forget_content_hash() {
+        hashed_data = nullptr;
+        hashed_size = 0;
+    }
+};
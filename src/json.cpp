@@ -0,0 +1,330 @@
+#include "json.hpp"
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+JsonValue JsonValue::make_number(double value) {
+    JsonValue result;
+    result.type = Number;
+    result.number = value;
+    return result;
+}
+
+JsonValue JsonValue::make_string(const std::string& value) {
+    JsonValue result;
+    result.type = String;
+    result.string = value;
+    return result;
+}
+
+JsonValue JsonValue::make_array() {
+    JsonValue result;
+    result.type = Array;
+    return result;
+}
+
+JsonValue JsonValue::make_object() {
+    JsonValue result;
+    result.type = Object;
+    return result;
+}
+
+const JsonValue* JsonValue::find(const std::string& key) const {
+    for (const auto& [member_key, member_value] : object) {
+        if (member_key == key) {
+            return &member_value;
+        }
+    }
+
+    return nullptr;
+}
+
+JsonValue* JsonValue::find(const std::string& key) {
+    return const_cast<JsonValue*>(std::as_const(*this).find(key));
+}
+
+// Set an object member, replacing the existing value if the key already exists.
+
+JsonValue& JsonValue::set(const std::string& key, JsonValue value) {
+    for (auto& [member_key, member_value] : object) {
+        if (member_key == key) {
+            member_value = std::move(value);
+            return member_value;
+        }
+    }
+
+    object.emplace_back(key, std::move(value));
+    return object.back().second;
+}
+
+double JsonValue::get_number(const std::string& key, double fallback) const {
+    const JsonValue* member = find(key);
+    return (member != nullptr && member->type == Number) ? member->number : fallback;
+}
+
+std::string escape_string(const std::string& value) {
+    std::string escaped = "\"";
+
+    for (char c : value) {
+        switch (c) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n";  break;
+            case '\t': escaped += "\\t";  break;
+            default:   escaped += c;      break;
+        }
+    }
+
+    return escaped + "\"";
+}
+
+// Serialize the value. Arrays of numbers are written on a single line, since
+// these are typically long lists of timing samples; everything else is written
+// with one member or element per line.
+
+std::string JsonValue::serialize(int indent) const {
+    std::string padding = std::string(indent + 2, ' ');
+    std::string closing_padding = std::string(indent, ' ');
+
+    switch (type) {
+        case Null:
+            return "null";
+
+        case Boolean:
+            return boolean ? "true" : "false";
+
+        case Number:
+            if (std::isfinite(number) && number == std::round(number) && std::abs(number) < 1e15) {
+                return std::format("{}", (long) number);
+            } else {
+                return std::isfinite(number) ? std::format("{:.4f}", number) : "null";
+            }
+
+        case String:
+            return escape_string(string);
+
+        case Array: {
+            bool all_numbers = true;
+
+            for (const JsonValue& element : array) {
+                all_numbers = all_numbers && element.type == Number;
+            }
+
+            std::string output = "[";
+            std::string separator = all_numbers ? ", " : ",\n" + padding;
+            output += (all_numbers || array.empty()) ? "" : "\n" + padding;
+
+            for (size_t index = 0; index < array.size(); ++index) {
+                output += (index > 0 ? separator : "") + array[index].serialize(indent + 2);
+            }
+
+            output += (all_numbers || array.empty()) ? "" : "\n" + closing_padding;
+            return output + "]";
+        }
+
+        case Object: {
+            if (object.empty()) {
+                return "{}";
+            }
+
+            std::string output = "{\n";
+
+            for (size_t index = 0; index < object.size(); ++index) {
+                const auto& [key, value] = object[index];
+                output += padding + escape_string(key) + ": " + value.serialize(indent + 2);
+                output += (index + 1 < object.size()) ? ",\n" : "\n";
+            }
+
+            return output + closing_padding + "}";
+        }
+    }
+
+    return "null";
+}
+
+// Recursive descent parser over a string view. Each parse function consumes the
+// characters of one value from the front of the view, and returns an empty
+// optional if the input is not valid JSON.
+
+struct JsonParser {
+    std::string_view text;
+
+    void skip_whitespace() {
+        while (!text.empty() && std::isspace((unsigned char) text.front())) {
+            text.remove_prefix(1);
+        }
+    }
+
+    bool consume(char c) {
+        skip_whitespace();
+
+        if (!text.empty() && text.front() == c) {
+            text.remove_prefix(1);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool consume_literal(std::string_view literal) {
+        if (text.starts_with(literal)) {
+            text.remove_prefix(literal.size());
+            return true;
+        }
+
+        return false;
+    }
+
+    std::optional<std::string> parse_string() {
+        if (!consume('"')) {
+            return std::nullopt;
+        }
+
+        std::string result;
+
+        while (!text.empty() && text.front() != '"') {
+            char c = text.front();
+            text.remove_prefix(1);
+
+            if (c == '\\' && !text.empty()) {
+                char escaped = text.front();
+                text.remove_prefix(1);
+                result += (escaped == 'n') ? '\n' : (escaped == 't') ? '\t' : escaped;
+            } else {
+                result += c;
+            }
+        }
+
+        return consume('"') ? std::optional(result) : std::nullopt;
+    }
+
+    std::optional<JsonValue> parse_value() {
+        skip_whitespace();
+
+        if (text.empty()) {
+            return std::nullopt;
+        }
+
+        JsonValue value;
+
+        switch (text.front()) {
+            case '{': {
+                value = JsonValue::make_object();
+                text.remove_prefix(1);
+
+                if (consume('}')) {
+                    return value;
+                }
+
+                do {
+                    auto key = parse_string();
+
+                    if (!key || !consume(':')) {
+                        return std::nullopt;
+                    }
+
+                    auto member = parse_value();
+
+                    if (!member) {
+                        return std::nullopt;
+                    }
+
+                    value.object.emplace_back(*key, std::move(*member));
+                } while (consume(','));
+
+                return consume('}') ? std::optional(value) : std::nullopt;
+            }
+
+            case '[': {
+                value = JsonValue::make_array();
+                text.remove_prefix(1);
+
+                if (consume(']')) {
+                    return value;
+                }
+
+                do {
+                    auto element = parse_value();
+
+                    if (!element) {
+                        return std::nullopt;
+                    }
+
+                    value.array.push_back(std::move(*element));
+                } while (consume(','));
+
+                return consume(']') ? std::optional(value) : std::nullopt;
+            }
+
+            case '"': {
+                auto string = parse_string();
+                return string ? std::optional(JsonValue::make_string(*string)) : std::nullopt;
+            }
+
+            default:
+                break;
+        }
+
+        if (consume_literal("null")) {
+            return value;
+        } else if (consume_literal("true")) {
+            value.type = JsonValue::Boolean;
+            value.boolean = true;
+            return value;
+        } else if (consume_literal("false")) {
+            value.type = JsonValue::Boolean;
+            return value;
+        }
+
+        double number = 0.0;
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+
+        if (error != std::errc()) {
+            return std::nullopt;
+        }
+
+        text.remove_prefix(end - text.data());
+        return JsonValue::make_number(number);
+    }
+};
+
+std::optional<JsonValue> JsonValue::parse(std::string_view text) {
+    JsonParser parser { text };
+    auto value = parser.parse_value();
+    parser.skip_whitespace();
+    return parser.text.empty() ? value : std::nullopt;
+}
+
+std::optional<JsonValue> read_json_file(const std::string& filename) {
+    std::ifstream file(filename);
+
+    if (!file) {
+        return std::nullopt;
+    }
+
+    std::string text { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    return JsonValue::parse(text);
+}
+
+// Write a value to a file, creating the parent directory if needed.
+
+void write_json_file(const std::string& filename, const JsonValue& value) {
+    std::filesystem::path path = std::filesystem::path(filename);
+
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+    }
+
+    std::ofstream file(filename);
+    file << value.serialize() << "\n";
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Minimal JSON value, used to store and compare benchmark results. Objects keep
+// their keys in insertion order, so that serialized files are stable and easy
+// to diff. This is not a general-purpose JSON library: numbers are always stored
+// as doubles, and string escapes are limited to the ones we write ourselves.
+
+struct JsonValue {
+    enum Type { Null, Boolean, Number, String, Array, Object };
+
+    Type type = Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    static JsonValue make_number(double value);
+    static JsonValue make_string(const std::string& value);
+    static JsonValue make_array();
+    static JsonValue make_object();
+
+    const JsonValue* find(const std::string& key) const;
+    JsonValue* find(const std::string& key);
+    JsonValue& set(const std::string& key, JsonValue value);
+    double get_number(const std::string& key, double fallback) const;
+
+    std::string serialize(int indent = 0) const;
+
+    static std::optional<JsonValue> parse(std::string_view text);
+};
+
+std::optional<JsonValue> read_json_file(const std::string& filename);
+
+void write_json_file(const std::string& filename, const JsonValue& value);
@@ -1,94 +1,894 @@
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
 #include <fstream>
+#include <map>
+#include <optional>
 #include <print>
+#include <ranges>
+#include <set>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "batch.hpp"
+#include "build_flavour.hpp"
+#include "end_to_end.hpp"
+#include "generator.hpp"
+#include "input.hpp"
+#include "input_cache.hpp"
+#include "json.hpp"
+#include "profile.hpp"
+#include "regression.hpp"
+#include "report.hpp"
+#include "sampler.hpp"
+#include "scaling.hpp"
+#include "server.hpp"
 #include "solution.hpp"
+#include "solve_context.hpp"
+#include "statistics.hpp"
+#include "stream.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
 
-// Number of runs when profiling
-const int PROFILE_RUNS = 20;
+// Default number of warm-up and timed runs when profiling
+const int DEFAULT_WARMUP_RUNS = 1;
+const int DEFAULT_PROFILE_RUNS = 20;
 
-// Signature of the solve() function, to be implemented by the individual solution files.
-//
-// The Makefile is set up to include only the solution file for current day and part (e.g,
-// 'solutions/01/solve_a.cpp' for day 1 and part A), so there will only ever be one target
-// solve() implementation for the linker. The 'input_name' argument contains the base name
-// of the input file (e.g. 'sample' or 'input'), which can for example be used if the
-// sample input and the real input use different logic and/or constraints.
+// Default increase of the median runtime (in percent) above which a regression
+// check fails, provided that the increase is statistically significant
+const double DEFAULT_REGRESSION_THRESHOLD = 5.0;
 
-Solution solve(const std::vector<std::string>& lines, const std::string& input_name);
+// Default scales and seed of generated inputs, and the default number of timed
+// runs per input when measuring complexity, which is lower than for regular
+// profiling since the larger inputs can take seconds per run
+const std::vector<size_t> DEFAULT_SCALES = { 10, 100, 1000, 10000 };
+const uint64_t DEFAULT_SEED = 2025;
+const int DEFAULT_COMPLEXITY_RUNS = 5;
+
+// Default number of concurrent clients and total number of requests when querying
+// a running server
+const size_t DEFAULT_QUERY_CLIENTS = 1;
+const size_t DEFAULT_QUERY_REQUESTS = 100;
+
+// When measuring complexity, skip scales at which the predicted median runtime of
+// a solution exceeds this limit (in microseconds)
+const double COMPLEXITY_TIME_LIMIT_US = 1000000.0;
+
+// Directory in which the results of the previous sweep are stored
+const std::string BENCH_DIRECTORY = "bench";
+
+// Modes of operation, selected by the (optional) third argument:
+// - Run: Run the solution once, and print the solution and runtime.
+// - Profile: Run the solution repeatedly, and print timing statistics.
+// - Cold: Profile the solution both on warm and on cold caches, and print the
+//   timing statistics side by side.
+// - Sweep: Profile all selected solutions, and print a results table.
+// - Baseline: Profile all selected solutions, and store their timings.
+// - Check: Profile all selected solutions, and compare against the baseline.
+// - Generate: Write generated inputs of different scales for all selected days.
+// - Complexity: Profile all selected solutions on generated inputs of different
+//   scales, and fit the empirical complexity exponent.
+// - Ingest: Measure the bandwidth of loading the input files of all selected
+//   solutions, and of splitting them into lines serially and in parallel.
+// - Stream: Run the selected streaming solutions once, reading the input in
+//   blocks while solving, and print the solution, runtime and throughput.
+// - Serve: Keep the selected solutions resident, and solve requests received on
+//   a Unix domain socket until a client requests a shutdown.
+// - Query: Send solve requests for the selected solutions to a running server
+//   from concurrent clients, and print the throughput and latency.
+// - EndToEnd: Run the solution repeatedly in a fresh process, and break down the
+//   wall time of a run into process startup, input loading, and solving.
+// - Batch: Run the solution over all input files matching a glob pattern (given
+//   instead of the input name), and print the throughput and latency.
+// - Scaling: Profile the solution with increasing numbers of threads, and print
+//   the speedup, parallel efficiency and serial fraction per thread count.
+
+enum Mode { Run, Profile, Cold, Sweep, Baseline, Check, Generate, Complexity, Ingest, Stream, Serve, Query, EndToEnd, Batch, Scaling };
 
 struct Arguments {
-    std::string day;
+    std::string day_part;
     std::string input_name;
-    bool do_profile;
+    Mode mode;
+    ProfileOptions profile_options;
+    std::string sweep_format;
+    std::string output_filename;
+    std::string trace_filename;
+    std::string baseline_filename;
+    double threshold_percent;
+    std::vector<size_t> scales;
+    uint64_t seed;
+    size_t thread_count;
+    bool cold_cache;
+    std::string socket_path;
+    size_t client_count;
+    size_t request_count;
+    bool shutdown_server;
+    std::string program_path;
+    bool is_child;
+    std::string sample_filename;
+    bool pin_threads;
 };
 
-std::vector<std::string> read_input_file(Arguments& arguments) {
-    std::string filename = "data/" + arguments.day + "/" + arguments.input_name + ".txt";
+// Parse the command line arguments. The first two arguments (day/part and input
+// name) are required; the day/part may also be 'all' to select every solution
+// that is linked into the binary. The third argument selects the mode ('profile',
+// 'cold', 'sweep', 'baseline', 'check', 'generate', 'complexity', 'ingest', 'stream',
+// 'serve', 'query', 'e2e', 'batch' or 'scaling'; running once if omitted), and may be followed
+// by these options:
+// - '--warmup <runs>', '--runs <runs>', '--budget <milliseconds>', and/or the
+//   '--counters' flag to enable hardware performance counters;
+// - the '--trace' flag to aggregate traced phases, and/or '--trace-output <file>'
+//   to also write the trace events to a Chrome trace file;
+// - '--format <markdown|csv|json>' and '--output <file>' for sweeps;
+// - '--baseline <file>' and '--threshold <percent>' for baselines and checks;
+// - '--scales <scale,...>' and '--seed <seed>' for generated inputs. In these
+//   modes, the input name is the prefix of the input files (e.g. 'scaled');
+// - '--threads <count>' to set the number of threads of the shared thread pool
+//   (including the main thread), or the largest thread count when measuring
+//   thread scaling. This option, '--no-cache' and '--sample' are the
+//   only ones allowed in run mode;
+// - the '--cold' flag to evict the input from the page cache before streaming,
+//   or before every cold or end-to-end run;
+// - the '--no-cache' flag to disable the binary input cache, so that solutions
+//   that use it parse their input on every run;
+// - '--socket <path>' for the socket of the server, and '--clients <count>',
+//   '--requests <count>' and/or the '--shutdown' flag (to stop the server after
+//   the requests) when querying it;
+// - the '--child' flag, which the end-to-end mode passes to the processes that
+//   it starts, to load and solve the input once and report the timestamps;
+// - '--sample <file>' to run the built-in sampling profiler for the lifetime of
+//   the process, and write folded stacks to the given file (allowed in any mode);
+// - the '--pin' flag to pin threads to distinct CPUs when measuring thread scaling.
+
+Arguments parse_arguments(int argc, char **argv) {
+    assert(argc >= 3);
+    std::string day_part = std::string(argv[1]);
+    assert(day_part.length() == 3);
+    std::string input_name = std::string(argv[2]);
+    std::string mode_name = (argc >= 4) ? std::string(argv[3]) : "run";
+    const std::map<std::string, Mode> modes {
+        { "run", Run }, { "profile", Profile }, { "cold", Cold }, { "sweep", Sweep }, { "baseline", Baseline }, { "check", Check },
+        { "generate", Generate }, { "complexity", Complexity }, { "ingest", Ingest }, { "stream", Stream },
+        { "serve", Serve }, { "query", Query }, { "e2e", EndToEnd }, { "batch", Batch }, { "scaling", Scaling }
+    };
+    assert(modes.contains(mode_name) && "unknown mode");
+    Mode mode = modes.at(mode_name);
+
+    std::string baseline_filename = BENCH_DIRECTORY + "/baseline_" + input_name + ".json";
+    Arguments arguments {
+        day_part, input_name, mode, {}, "markdown", "", "",
+        baseline_filename, DEFAULT_REGRESSION_THRESHOLD, DEFAULT_SCALES, DEFAULT_SEED, 0, false,
+        DEFAULT_SOCKET_PATH, DEFAULT_QUERY_CLIENTS, DEFAULT_QUERY_REQUESTS, false,
+        std::string(argv[0]), false, "", false
+    };
+    ProfileOptions& profile_options = arguments.profile_options;
+    int runs = (mode == Complexity) ? DEFAULT_COMPLEXITY_RUNS : DEFAULT_PROFILE_RUNS;
+    profile_options = ProfileOptions { DEFAULT_WARMUP_RUNS, runs, 0.0, false, false };
+
+    for (int index = 4; index < argc; ++index) {
+        std::string option = std::string(argv[index]);
+        assert(mode != Run || option == "--threads" || option == "--no-cache" || option == "--sample");
+
+        if (option == "--counters") {
+            profile_options.use_counters = true;
+            continue;
+        } else if (option == "--trace") {
+            profile_options.use_tracing = true;
+            continue;
+        } else if (option == "--cold") {
+            arguments.cold_cache = true;
+            continue;
+        } else if (option == "--no-cache") {
+            set_input_cache_enabled(false);
+            continue;
+        } else if (option == "--shutdown") {
+            arguments.shutdown_server = true;
+            continue;
+        } else if (option == "--child") {
+            arguments.is_child = true;
+            continue;
+        } else if (option == "--pin") {
+            arguments.pin_threads = true;
+            continue;
+        }
+
+        assert(index + 1 < argc);
+        std::string value = std::string(argv[++index]);
+
+        if (option == "--warmup") {
+            profile_options.warmup_runs = std::stoi(value);
+            assert(profile_options.warmup_runs >= 0);
+        } else if (option == "--runs") {
+            profile_options.runs = std::stoi(value);
+        } else if (option == "--budget") {
+            profile_options.budget_ms = std::stod(value);
+        } else if (option == "--format") {
+            assert(value == "markdown" || value == "csv" || value == "json");
+            arguments.sweep_format = value;
+        } else if (option == "--output") {
+            arguments.output_filename = value;
+        } else if (option == "--baseline") {
+            arguments.baseline_filename = value;
+        } else if (option == "--threshold") {
+            arguments.threshold_percent = std::stod(value);
+        } else if (option == "--scales") {
+            arguments.scales.clear();
+
+            for (auto scale : std::views::split(value, ',')) {
+                arguments.scales.push_back(std::stoul(std::string(std::string_view(scale))));
+            }
+        } else if (option == "--seed") {
+            arguments.seed = std::stoull(value);
+        } else if (option == "--trace-output") {
+            profile_options.use_tracing = true;
+            arguments.trace_filename = value;
+        } else if (option == "--threads") {
+            arguments.thread_count = std::stoul(value);
+            assert(arguments.thread_count > 0);
+        } else if (option == "--socket") {
+            arguments.socket_path = value;
+        } else if (option == "--clients") {
+            arguments.client_count = std::stoul(value);
+            assert(arguments.client_count > 0);
+        } else if (option == "--requests") {
+            arguments.request_count = std::stoul(value);
+        } else if (option == "--sample") {
+            arguments.sample_filename = value;
+        } else {
+            assert(false && "unknown option");
+        }
+    }
+
+    // Without a budget, the number of timed runs is fixed, and every profiling
+    // mode needs at least one timed run to report on.
+    assert((profile_options.budget_ms > 0.0 || profile_options.runs >= 1) && "at least one timed run is required");
+    return arguments;
+}
+
+// Run a solution once, and print the solution and the runtime.
+
+void run_solution(const std::string& day_part, const Solver& solve, const Arguments& arguments) {
+    auto filename = get_input_filename(day_part, arguments.input_name);
     std::println("Reading input file '{}'...", filename);
-    std::ifstream input_file(filename);
-    assert(input_file);
+    InputFile input_file(filename);
+    SolveContext context;
+
+    std::println("Running solution...");
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    auto solution = solve(input_file.lines, arguments.input_name, context);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+    auto duration_ms = (double) duration_ns.count() / 1000000.0;
+
+    std::println("Solution: {}", stringify(solution));
+    std::println("Completed in {:.3f} ms", duration_ms);
+}
+
+// Profile a solution, and print the full set of statistics.
 
-    std::vector<std::string> lines;
-    std::string line;
+void print_profile(const std::string& day_part, const Solver& solve, const Arguments& arguments) {
+    auto filename = get_input_filename(day_part, arguments.input_name);
+    std::println("Reading input file '{}'...", filename);
+    InputFile input_file(filename);
+    const ProfileOptions& options = arguments.profile_options;
 
-    while (std::getline(input_file, line)) {
-        lines.push_back(line);
+    if (options.budget_ms > 0.0) {
+        std::println("Profiling solution ({} warm-up runs, {:.0f} ms budget)...", options.warmup_runs, options.budget_ms);
+    } else {
+        std::println("Profiling solution ({} warm-up runs, {} timed runs)...", options.warmup_runs, options.runs);
     }
 
-    return lines;
+    auto result = profile_solution(solve, input_file.lines, arguments.input_name, options);
+    print_profile_result(result);
+
+    if (!arguments.trace_filename.empty()) {
+        write_chrome_trace(arguments.trace_filename, result.trace_events);
+        std::println("Wrote {} trace events to '{}'", result.trace_events.size(), arguments.trace_filename);
+    }
 }
 
-Arguments parse_arguments(int argc, char **argv) {
-    assert(argc == 3 || argc == 4);
-    std::string day_part = std::string(argv[1]);
-    assert(day_part.length() == 3);
-    std::string day = day_part.substr(0, 2);
-    std::string input_name = std::string(argv[2]);
-    bool do_profile = argc == 4 && std::string(argv[3]) == "profile";
+// Profile a solution on warm caches (as in the profile mode) and on cold caches,
+// and print both sets of statistics side by side. Both use the same number of
+// timed runs (or the same time budget).
 
-    return Arguments { day, input_name, do_profile };
+void print_cold_profile(const std::string& day_part, const Solver& solve, const Arguments& arguments) {
+    auto filename = get_input_filename(day_part, arguments.input_name);
+    std::println("Reading input file '{}'...", filename);
+    InputFile input_file(filename);
+    const ProfileOptions& options = arguments.profile_options;
+
+    if (options.budget_ms > 0.0) {
+        std::println("Profiling solution on warm and cold caches ({:.0f} ms budget each)...", options.budget_ms);
+    } else {
+        std::println("Profiling solution on warm and cold caches ({} runs each)...", options.runs);
+    }
+
+    auto warm = profile_solution(solve, input_file.lines, arguments.input_name, options);
+    auto cold = profile_cold_solution(solve, filename, arguments.input_name, options, arguments.cold_cache);
+    print_cold_profile_result(warm, cold);
 }
 
-int main(int argc, char **argv) {
-    auto arguments = parse_arguments(argc, argv);
-    auto lines = read_input_file(arguments);
+// Run a solution end-to-end in fresh processes (see 'end_to_end.hpp'): first the
+// warm-up runs, whose results are discarded, and then the timed runs. The child
+// processes use the same number of threads, and always run without the binary
+// input cache, so that every run parses its input like a first run on a new
+// input would, and the Parse step is not skipped for the days that cache it.
+// With '--cold', the input is evicted from the page cache before every run.
 
-    if (arguments.do_profile) {
-        std::println("Profiling solution...");
-        double total_ms = 0.0;
+void print_end_to_end(const std::string& day_part, const Arguments& arguments) {
+    auto filename = get_input_filename(day_part, arguments.input_name);
+    std::vector<std::string> child_arguments = { day_part, arguments.input_name, "e2e", "--child", "--no-cache" };
 
-        // ignore the time of the first run
-        solve(lines, arguments.input_name);
+    if (arguments.thread_count > 0) {
+        child_arguments.insert(child_arguments.end(), { "--threads", std::to_string(arguments.thread_count) });
+    }
+
+    const ProfileOptions& options = arguments.profile_options;
+    std::println("Running solution end-to-end in fresh processes ({} runs)...", options.runs);
+
+    for (int run = 0; run < options.warmup_runs; ++run) {
+        run_end_to_end(arguments.program_path, child_arguments, filename, arguments.cold_cache);
+    }
 
-        for (int i = 0; i != PROFILE_RUNS; i++) {
-            auto start_time = std::chrono::high_resolution_clock::now();
-            
-            solve(lines, arguments.input_name);
+    std::vector<EndToEndRun> runs;
 
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
-            auto duration_ms = (double) duration_ns.count() / 1000000.0;
-            total_ms += duration_ms;
+    for (int run = 0; run < options.runs; ++run) {
+        runs.push_back(run_end_to_end(arguments.program_path, child_arguments, filename, arguments.cold_cache));
+        assert(runs.back().solution == runs.front().solution && "end-to-end runs produced different solutions");
+    }
+
+    print_end_to_end_runs(runs);
+}
+
+// Profile a solution at increasing thread counts (see 'scaling.hpp'), up to the
+// thread count set by '--threads', or one thread per hardware thread by default.
+
+void print_scaling(const std::string& day_part, const Solver& solve, const Arguments& arguments) {
+    auto filename = get_input_filename(day_part, arguments.input_name);
+    std::println("Reading input file '{}'...", filename);
+    InputFile input_file(filename);
+    size_t max_thread_count = (arguments.thread_count > 0) ? arguments.thread_count : get_default_thread_count();
+
+    std::println("Profiling solution at 1 to {} threads{}...", max_thread_count, arguments.pin_threads ? " (pinned)" : "");
+    std::println("Build:   {}", BUILD_FLAVOUR);
+    auto points = run_scaling(solve, input_file.lines, arguments.input_name, arguments.profile_options,
+        max_thread_count, arguments.pin_threads);
+    print_scaling_result(points);
+}
+
+// Profile all selected solutions for which the input file exists, using the same
+// profiling options as the profile mode, and print a one-line summary for each.
+
+std::map<std::string, ProfileResult> profile_all(const std::map<std::string, Solver>& solutions, const Arguments& arguments) {
+    std::map<std::string, ProfileResult> results;
+
+    for (const auto& [day_part, solve] : solutions) {
+        auto filename = get_input_filename(day_part, arguments.input_name);
+
+        if (!std::filesystem::exists(filename)) {
+            continue;
         }
 
-        auto average_ms = total_ms / (double) PROFILE_RUNS;
-        std::println("Average over {} runs: {:.3f} ms", PROFILE_RUNS, average_ms);
+        InputFile input_file(filename);
+        auto result = profile_solution(solve, input_file.lines, arguments.input_name, arguments.profile_options);
+        const Statistics& stats = result.statistics;
+        std::println("{}: {:>12.2f} μs ± {:.2f} ({} runs, peak heap {} bytes)", day_part, stats.mean, stats.ci_high - stats.mean,
+            stats.count, format_thousands((long) get_peak_heap_bytes(result)));
+        results[day_part] = std::move(result);
+    }
+
+    return results;
+}
+
+// Profile all selected solutions, and print one results table. The table includes
+// the change relative to the previous sweep on the same input, which is stored
+// in the bench directory. The stored results are then updated with those of this
+// sweep; results for solutions that were not part of this sweep are kept.
+
+void sweep(const std::map<std::string, Solver>& solutions, const Arguments& arguments) {
+    SweepResults results;
+
+    for (const auto& [day_part, result] : profile_all(solutions, arguments)) {
+        results[day_part] = result.statistics;
+    }
+
+    std::string state_filename = BENCH_DIRECTORY + "/sweep_" + arguments.input_name + ".json";
+    auto previous = read_json_file(state_filename);
+    const JsonValue* previous_ptr = previous ? &previous.value() : nullptr;
+    JsonValue json = format_sweep_json(results, arguments.input_name, previous_ptr);
+    json.set("build", JsonValue::make_string(BUILD_FLAVOUR));
+    json.set("input_cache", JsonValue::make_string(is_input_cache_enabled() ? "on" : "off"));
+
+    std::string output;
+
+    if (arguments.sweep_format == "csv") {
+        output = format_sweep_csv(results, previous_ptr);
+    } else if (arguments.sweep_format == "json") {
+        output = json.serialize() + "\n";
     } else {
-        std::println("Running solution...");
+        output = format_sweep_markdown(results, previous_ptr);
+    }
+
+    std::println("");
+    std::println("Build: {}", BUILD_FLAVOUR);
+    std::println("Input cache: {}", is_input_cache_enabled() ? "on" : "off (parsing included)");
+    std::print("{}", output);
+
+    if (!arguments.output_filename.empty()) {
+        std::ofstream output_file(arguments.output_filename);
+        output_file << output;
+    }
+
+    if (previous && previous->find("results") != nullptr) {
+        JsonValue& json_results = *json.find("results");
+
+        for (const auto& [day_part, entry] : previous->find("results")->object) {
+            if (json_results.find(day_part) == nullptr) {
+                json_results.set(day_part, entry);
+            }
+        }
+    }
+
+    write_json_file(state_filename, json);
+}
+
+// Profile all selected solutions, and store their raw timing samples as the
+// baseline for later checks. Like for sweeps, baseline entries of solutions
+// that were not profiled this time are kept. The peak heap usage of parallel
+// solutions depends on the thread count, so the baseline stores the thread
+// count, and kept entries lose their peak heap if it changed.
+
+void record_baseline(const std::map<std::string, Solver>& solutions, const Arguments& arguments) {
+    BaselineSamples samples;
+    BaselinePeakHeap peak_heap;
+
+    for (const auto& [day_part, result] : profile_all(solutions, arguments)) {
+        samples[day_part] = result.samples_us;
+        peak_heap[day_part] = get_peak_heap_bytes(result);
+    }
+
+    auto previous = read_json_file(arguments.baseline_filename);
+    size_t thread_count = get_thread_pool().thread_count();
+
+    if (previous && previous->find("results") != nullptr) {
+        bool is_same_thread_count = get_baseline_thread_count(previous.value()) == thread_count;
+
+        for (const auto& [day_part, entry] : previous->find("results")->object) {
+            if (!samples.contains(day_part)) {
+                samples[day_part] = get_baseline_samples(previous.value(), day_part);
+
+                if (is_same_thread_count) {
+                    peak_heap[day_part] = get_baseline_peak_heap_bytes(previous.value(), day_part);
+                }
+            }
+        }
+    }
+
+    JsonValue json = format_baseline_json(samples, peak_heap, arguments.input_name);
+    json.set("build", JsonValue::make_string(BUILD_FLAVOUR));
+    json.set("threads", JsonValue::make_number((double) thread_count));
+    write_json_file(arguments.baseline_filename, json);
+    std::println("Wrote baseline of {} solutions to '{}'", samples.size(), arguments.baseline_filename);
+}
+
+// Profile all selected solutions that have a baseline, and compare their timings
+// against it. Returns the exit code of the program, which is non-zero if at least
+// one solution regressed, so that the check can be used in scripts.
+
+int check_baseline(const std::map<std::string, Solver>& solutions, const Arguments& arguments) {
+    auto baseline = read_json_file(arguments.baseline_filename);
+
+    if (!baseline) {
+        std::println("No baseline found at '{}'; record one using the 'baseline' mode first", arguments.baseline_filename);
+        return 2;
+    }
+
+    std::map<std::string, Solver> checked_solutions;
+
+    for (const auto& [day_part, solve] : solutions) {
+        if (!get_baseline_samples(baseline.value(), day_part).empty()) {
+            checked_solutions[day_part] = solve;
+        }
+    }
+
+    // Peak heap usage is only comparable at the thread count of the baseline,
+    // since chunk results and task storage of parallel solutions depend on it.
+    // Baselines that do not store their thread count are not compared either.
+    size_t baseline_thread_count = get_baseline_thread_count(baseline.value());
+    size_t thread_count = get_thread_pool().thread_count();
+    bool is_heap_checked = baseline_thread_count == thread_count;
+    std::vector<RegressionCheck> checks;
+
+    for (const auto& [day_part, result] : profile_all(checked_solutions, arguments)) {
+        auto baseline_samples = get_baseline_samples(baseline.value(), day_part);
+        auto baseline_peak_heap_bytes = is_heap_checked ? get_baseline_peak_heap_bytes(baseline.value(), day_part) : 0;
+        checks.push_back(check_regression(day_part, baseline_samples, result.samples_us,
+            baseline_peak_heap_bytes, get_peak_heap_bytes(result), arguments.threshold_percent));
+    }
+
+    std::println("");
+    std::print("{}", format_regression_table(checks));
+
+    // Comparing timings of different build flavours is usually a mistake.
+    const JsonValue* baseline_build = baseline->find("build");
+
+    if (baseline_build != nullptr && baseline_build->string != BUILD_FLAVOUR) {
+        std::println("Warning: baseline was recorded with build '{}', this is build '{}'", baseline_build->string, BUILD_FLAVOUR);
+    }
+
+    if (baseline_thread_count == 0) {
+        std::println("Warning: baseline does not store its thread count; heap usage was not checked");
+    } else if (!is_heap_checked) {
+        std::println("Warning: baseline was recorded with {} threads, this run uses {}; heap usage was not checked",
+            baseline_thread_count, thread_count);
+    }
+
+    bool has_regression = std::ranges::any_of(checks, [](const RegressionCheck& check) {
+        return check.is_regression || check.is_memory_regression;
+    });
+    return has_regression ? 1 : 0;
+}
+
+// Write generated inputs of all requested scales for every selected day that has
+// a generator, to 'data/DD/<input_name>_<scale>.txt'. Every file gets its own
+// random stream, derived from the seed, the day, and the scale, so that files
+// do not depend on which other days or scales are generated in the same run.
+
+void generate_inputs(const Arguments& arguments) {
+    for (const auto& [day, generate] : get_generators()) {
+        if (arguments.day_part != "all" && !arguments.day_part.starts_with(day)) {
+            continue;
+        }
+
+        for (size_t scale : arguments.scales) {
+            auto filename = get_input_filename(day, arguments.input_name + "_" + std::to_string(scale));
+            std::filesystem::create_directories(std::filesystem::path(filename).parent_path());
+            std::ofstream output_file(filename);
+
+            Random random(arguments.seed, std::stoul(day) * 1000003 + scale);
+            bool is_supported = generate(output_file, scale, random);
+            output_file.close();
+
+            if (!is_supported) {
+                std::filesystem::remove(filename);
+                std::println("{}: scale {} is not supported by the input format, skipping", day, scale);
+                continue;
+            }
+
+            long size = (long) std::filesystem::file_size(filename);
+            std::println("{}: wrote '{}' ({} bytes)", day, filename, format_thousands(size));
+        }
+    }
+}
+
+// Profile all selected solutions on the generated inputs of all requested scales,
+// print the median runtime per scale, and fit the complexity exponent over these
+// medians (see `fit_power_law_exponent()`). Before profiling a solution at the
+// next scale, we extrapolate its runtime from the previous scales (assuming
+// linear complexity if we only have one scale so far), and skip this and all
+// larger scales if it exceeds the time limit. This keeps e.g. quadratic solu-
+// tions from running for hours, or from running out of memory.
+
+void complexity(const std::map<std::string, Solver>& solutions, const Arguments& arguments) {
+    std::string header = std::format("{:<6}", "Task");
+
+    for (size_t scale : arguments.scales) {
+        header += std::format("{:>14}", std::to_string(scale) + "x");
+    }
+
+    std::println("Median runtime (μs) per input scale:");
+    std::println("{}  Exponent", header);
+
+    for (const auto& [day_part, solve] : solutions) {
+        std::vector<double> scales;
+        std::vector<double> medians;
+        std::string row = std::format("{:<6}", day_part);
+
+        for (size_t scale : arguments.scales) {
+            auto input_name = arguments.input_name + "_" + std::to_string(scale);
+            auto filename = get_input_filename(day_part, input_name);
+            bool over_limit = false;
+
+            if (!medians.empty()) {
+                double exponent = (scales.size() >= 2) ? fit_power_law_exponent(scales, medians) : 1.0;
+                double predicted_us = medians.back() * std::pow((double) scale / scales.back(), exponent);
+                over_limit = predicted_us > COMPLEXITY_TIME_LIMIT_US;
+            }
+
+            if (over_limit || !std::filesystem::exists(filename)) {
+                row += std::format("{:>14}", "-");
+                continue;
+            }
+
+            InputFile input_file(filename);
+            auto result = profile_solution(solve, input_file.lines, input_name, arguments.profile_options);
+            scales.push_back((double) scale);
+            medians.push_back(result.statistics.median);
+            row += std::format("{:>14.1f}", result.statistics.median);
+        }
+
+        if (scales.size() >= 2) {
+            row += std::format("{:>10.2f}", fit_power_law_exponent(scales, medians));
+        } else {
+            row += std::format("{:>10}", "-");
+        }
+
+        std::println("{}", row);
+    }
+}
+
+// Run the selected streaming solutions once on their input files, which are read
+// in blocks on a background thread while the solution consumes earlier blocks (see
+// 'stream.hpp'), so that memory use does not depend on the size of the input. When
+// requested, the input file is first evicted from the page cache, so that reading
+// it has to go to the disk. Besides the total time, print the time spent by the
+// reader thread in read calls, and the time that the solving thread spent waiting
+// for I/O and computing; the total approaches the maximum of the read and compute
+// times if they overlap well, and their sum if they do not overlap at all.
+
+void stream(const Arguments& arguments) {
+    for (const auto& [day_part, solve] : get_streaming_solutions()) {
+        if (arguments.day_part != "all" && arguments.day_part != day_part) {
+            continue;
+        }
+
+        auto filename = get_input_filename(day_part, arguments.input_name);
+        std::println("=== {} ===", day_part);
+
+        if (!std::filesystem::exists(filename)) {
+            std::println("No '{}' input file, skipping", arguments.input_name);
+            continue;
+        }
+
+        if (arguments.cold_cache) {
+            evict_file_cache(filename);
+        }
+
+        StreamStats stats {};
         auto start_time = std::chrono::high_resolution_clock::now();
 
-        auto solution = solve(lines, arguments.input_name);
+        auto solution = solve([&](const LineConsumer& consume) { stats = stream_lines(filename, consume); });
 
         auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
-        auto duration_ms = (double) duration_ns.count() / 1000000.0;
+        double duration_us = std::chrono::duration<double, std::micro>(end_time - start_time).count();
 
         std::println("Solution: {}", stringify(solution));
-        std::println("Completed in {:.3f} ms", duration_ms);
+        std::println("Completed in {:.3f} ms ({:.2f} GB/s, {} blocks)",
+            duration_us / 1000.0, (double) stats.size / (duration_us * 1000.0), stats.block_count);
+        std::println("Read:     {:10.3f} ms (reader thread)", stats.read_us / 1000.0);
+        std::println("I/O wait: {:10.3f} ms", stats.wait_us / 1000.0);
+        std::println("Compute:  {:10.3f} ms", stats.compute_us / 1000.0);
+    }
+}
+
+// Time `split()` on the given buffer for the given number of runs, and return
+// the timing statistics (in microseconds) together with the resulting lines.
+
+template <typename Split>
+std::pair<Statistics, std::vector<std::string_view>> time_split(Split split, const char* data, size_t size, int runs) {
+    std::vector<double> samples_us;
+    std::vector<std::string_view> lines;
+
+    for (int run = 0; run < runs; ++run) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        lines = split(data, size);
+        auto end_time = std::chrono::high_resolution_clock::now();
+        samples_us.push_back(std::chrono::duration<double, std::micro>(end_time - start_time).count());
+    }
+
+    return { Statistics::compute(samples_us), std::move(lines) };
+}
+
+// Measure ingest bandwidth for the input file of every selected day: the time to
+// load it (mapping the file, faulting in its pages, and building the line index),
+// and the median time to split the mapped buffer into lines, both serially and
+// in parallel on the thread pool. Both splits must produce the same line index.
+// Bandwidth in GB/s is simply the number of bytes per nanosecond.
+
+void ingest(const std::map<std::string, Solver>& solutions, const Arguments& arguments) {
+    std::set<std::string> filenames;
+
+    for (const auto& [day_part, solve] : solutions) {
+        filenames.insert(get_input_filename(day_part, arguments.input_name));
+    }
+
+    std::println("Build:   {}", BUILD_FLAVOUR);
+    std::println("Threads: {}", get_thread_pool().thread_count());
+
+    for (const std::string& filename : filenames) {
+        if (!std::filesystem::exists(filename)) {
+            continue;
+        }
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+        InputFile input_file(filename);
+        auto end_time = std::chrono::high_resolution_clock::now();
+        double load_us = std::chrono::duration<double, std::micro>(end_time - start_time).count();
+
+        int runs = arguments.profile_options.runs;
+        auto [serial, serial_lines] = time_split(split_lines, input_file.data, input_file.size, runs);
+        auto [parallel, parallel_lines] = time_split(split_lines_parallel, input_file.data, input_file.size, runs);
+        assert(serial_lines == parallel_lines && "parallel split produced different lines");
+
+        auto get_bandwidth = [&](double time_us) { return (double) input_file.size / (time_us * 1000.0); };
+        std::println("");
+        std::println("Input:    {} ({} bytes, {} lines)", filename, input_file.size, input_file.lines.size());
+        std::println("Load:     {:10.2f} μs ({:.2f} GB/s)", load_us, get_bandwidth(load_us));
+        std::println("Serial:   {:10.2f} μs ({:.2f} GB/s)", serial.median, get_bandwidth(serial.median));
+        std::println("Parallel: {:10.2f} μs ({:.2f} GB/s)", parallel.median, get_bandwidth(parallel.median));
+    }
+}
+
+// Send solve requests for every selected solution that has the requested input
+// file to a running server (see 'server.hpp'), from concurrent clients, and print
+// the throughput and round-trip latency as measured by the clients, followed by
+// the statistics of the server itself. The round trip includes the solve time,
+// so the difference with the solve time reported by the server is the overhead
+// of the socket and the protocol.
+
+void query(const std::map<std::string, Solver>& solutions, const Arguments& arguments) {
+    std::vector<std::string> requests;
+
+    for (const auto& [day_part, solve] : solutions) {
+        if (std::filesystem::exists(get_input_filename(day_part, arguments.input_name))) {
+            requests.push_back(std::format("solve {} {}", day_part, arguments.input_name));
+        }
+    }
+
+    if (requests.empty()) {
+        std::println("No '{}' input files, nothing to query", arguments.input_name);
+    } else if (arguments.request_count > 0) {
+        auto result = query_server(arguments.socket_path, requests, arguments.client_count, arguments.request_count);
+        std::vector<double> sorted_us = result.latencies_us;
+        std::ranges::sort(sorted_us);
+
+        std::println("Clients:    {}", arguments.client_count);
+        std::println("Requests:   {} ({} errors, {} distinct)", result.latencies_us.size(), result.error_count, requests.size());
+        std::println("Throughput: {:10.1f} requests/s", (double) result.latencies_us.size() / (result.duration_us / 1000000.0));
+        std::println("Median:     {:10.2f} μs (round trip)", percentile(sorted_us, 0.5));
+        std::println("P90:        {:10.2f} μs", percentile(sorted_us, 0.9));
+        std::println("P99:        {:10.2f} μs", percentile(sorted_us, 0.99));
+    }
+
+    std::println("Server:     {}", send_request(arguments.socket_path, "stats"));
+
+    if (arguments.shutdown_server) {
+        send_request(arguments.socket_path, "shutdown");
+        std::println("Requested server shutdown");
+    }
+}
+
+// Run a single solution over all input files matching the pattern that is given
+// instead of the input name (see 'batch.hpp'). The binary input cache is disabled,
+// since its files are named after the day and the file stem only: inputs outside
+// the data directory of the day, or with the same stem, would share and race on
+// one cache file, and the first batch would write cache files inside the measured
+// latency. Every input is therefore parsed as part of its latency.
+
+void batch(const std::map<std::string, Solver>& solutions, const Arguments& arguments) {
+    assert(arguments.day_part != "all" && "batch mode runs a single solution");
+    const auto& [day_part, solve] = *solutions.begin();
+    std::vector<std::string> filenames = expand_input_pattern(arguments.input_name);
+
+    if (filenames.empty()) {
+        std::println("No input files match '{}', nothing to run", arguments.input_name);
+        return;
+    }
+
+    set_input_cache_enabled(false);
+    std::println("Build:      {}", BUILD_FLAVOUR);
+    std::println("Threads:    {}", get_thread_pool().thread_count());
+    std::println("Cache:      off (every input is parsed)");
+    print_batch_result(run_batch(solve, filenames));
+}
+
+int main(int argc, char **argv) {
+    // Taken first, so that the end-to-end mode can separate process startup from
+    // argument parsing and setting up the thread pool.
+    int64_t main_ns = trace_now_ns();
+    auto arguments = parse_arguments(argc, argv);
+    std::map<std::string, Solver> solutions = get_solutions();
+
+    if (arguments.cold_cache && !FILE_CACHE_EVICTION_SUPPORTED) {
+        std::println("Page cache eviction is not supported on this platform, so '--cold' leaves inputs in the page cache");
+    }
+
+    if (arguments.pin_threads && !THREAD_PINNING_SUPPORTED) {
+        std::println("Thread pinning is not supported on this platform, so '--pin' has no effect");
+        arguments.pin_threads = false;
+    }
+
+    // Samples until main returns, after which the folded stacks are written.
+    std::optional<SamplingProfiler> sampler;
+
+    if (!arguments.sample_filename.empty()) {
+        sampler.emplace(arguments.sample_filename);
+    }
+
+    if (arguments.thread_count > 0) {
+        get_thread_pool().resize(arguments.thread_count);
+    }
+
+    if (arguments.mode == Stream) {
+        assert((arguments.day_part == "all" || get_streaming_solutions().contains(arguments.day_part)) &&
+            "not a streaming solution");
+        stream(arguments);
+        return 0;
+    }
+
+    if (arguments.day_part != "all") {
+        auto iter = solutions.find(arguments.day_part);
+        assert(iter != solutions.end() && "solution not linked into this binary");
+        solutions = { *iter };
+    }
+
+    if (arguments.mode == EndToEnd && arguments.is_child) {
+        assert(arguments.day_part != "all");
+        const auto& [day_part, solve] = *solutions.begin();
+        run_end_to_end_child(solve, get_input_filename(day_part, arguments.input_name), arguments.input_name, main_ns);
+        return 0;
+    }
+
+    if (arguments.mode == Sweep) {
+        sweep(solutions, arguments);
+        return 0;
+    } else if (arguments.mode == Baseline) {
+        record_baseline(solutions, arguments);
+        return 0;
+    } else if (arguments.mode == Check) {
+        return check_baseline(solutions, arguments);
+    } else if (arguments.mode == Generate) {
+        generate_inputs(arguments);
+        return 0;
+    } else if (arguments.mode == Complexity) {
+        complexity(solutions, arguments);
+        return 0;
+    } else if (arguments.mode == Ingest) {
+        ingest(solutions, arguments);
+        return 0;
+    } else if (arguments.mode == Serve) {
+        serve(solutions, arguments.input_name, arguments.socket_path);
+        return 0;
+    } else if (arguments.mode == Query) {
+        query(solutions, arguments);
+        return 0;
+    } else if (arguments.mode == Batch) {
+        batch(solutions, arguments);
+        return 0;
+    }
+
+    // Run or profile the selected solutions in order of day and part. When
+    // running all solutions, skip those without the requested input file.
+    for (const auto& [day_part, solve] : solutions) {
+        if (arguments.day_part == "all") {
+            std::println("=== {} ===", day_part);
+
+            if (!std::filesystem::exists(get_input_filename(day_part, arguments.input_name))) {
+                std::println("No '{}' input file, skipping", arguments.input_name);
+                continue;
+            }
+        }
+
+        if (arguments.mode == Profile) {
+            print_profile(day_part, solve, arguments);
+        } else if (arguments.mode == Cold) {
+            print_cold_profile(day_part, solve, arguments);
+        } else if (arguments.mode == EndToEnd) {
+            print_end_to_end(day_part, arguments);
+        } else if (arguments.mode == Scaling) {
+            print_scaling(day_part, solve, arguments);
+        } else {
+            run_solution(day_part, solve, arguments);
+        }
     }
 
     return 0;
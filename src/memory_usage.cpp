@@ -0,0 +1,100 @@
+#include "memory_usage.hpp"
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+#include <sys/resource.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+
+// Read a memory field (e.g. 'VmRSS' or 'VmHWM') from '/proc/self/status', where
+// it is listed in KB. Returns zero if the field is missing.
+
+size_t read_status_bytes(const std::string& field) {
+    std::ifstream status_file("/proc/self/status");
+    std::string line;
+
+    while (std::getline(status_file, line)) {
+        if (line.starts_with(field + ":")) {
+            return std::stoul(line.substr(field.size() + 1)) * 1024;
+        }
+    }
+
+    return 0;
+}
+
+// Writing '5' to 'clear_refs' resets the RSS high-water mark of the process to
+// its current RSS (Linux 4.0 and later). Without the reset, 'VmHWM' is the peak
+// over the lifetime of the process.
+
+MemoryProbe::MemoryProbe() : start_rss_bytes(0), start_minor_faults(0), start_major_faults(0) {
+    clear_refs_fd = open("/proc/self/clear_refs", O_WRONLY);
+}
+
+MemoryProbe::~MemoryProbe() {
+    if (clear_refs_fd != -1) {
+        close(clear_refs_fd);
+    }
+}
+
+void MemoryProbe::start() {
+    if (clear_refs_fd != -1 && write(clear_refs_fd, "5", 1) != 1) {
+        close(clear_refs_fd);
+        clear_refs_fd = -1;
+    }
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    start_minor_faults = usage.ru_minflt;
+    start_major_faults = usage.ru_majflt;
+    start_rss_bytes = read_status_bytes("VmRSS");
+}
+
+MemorySample MemoryProbe::stop() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    size_t peak_rss_bytes = read_status_bytes("VmHWM");
+
+    return MemorySample {
+        peak_rss_bytes,
+        peak_rss_bytes > start_rss_bytes ? peak_rss_bytes - start_rss_bytes : 0,
+        usage.ru_minflt - start_minor_faults,
+        usage.ru_majflt - start_major_faults,
+    };
+}
+
+#else
+
+// On macOS, the maximum RSS of `getrusage()` is in bytes, and there is no cheap
+// way to read the current RSS, so the growth during a run is not available.
+
+MemoryProbe::MemoryProbe() : clear_refs_fd(-1), start_rss_bytes(0), start_minor_faults(0), start_major_faults(0) {}
+
+MemoryProbe::~MemoryProbe() {}
+
+void MemoryProbe::start() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    start_minor_faults = usage.ru_minflt;
+    start_major_faults = usage.ru_majflt;
+}
+
+MemorySample MemoryProbe::stop() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    return MemorySample {
+        (size_t) usage.ru_maxrss,
+        0,
+        usage.ru_minflt - start_minor_faults,
+        usage.ru_majflt - start_major_faults,
+    };
+}
+
+#endif
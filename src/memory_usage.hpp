@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+// Resident memory and page faults of the process during a single run. The peak
+// resident set size (RSS) includes everything that was resident before the run
+// (the binary, the mapped input, the arena), so the growth over the RSS at the
+// start of the run is reported as well. Page faults are those of the process as
+// a whole, and therefore include faults in threads of the thread pool.
+//
+// On Linux, the kernel's RSS high-water mark is reset before every run (through
+// '/proc/self/clear_refs'), so the peak covers that run only. Elsewhere, or if
+// the reset is not allowed, only the peak over the lifetime of the process is
+// available, and `is_peak_per_run()` returns false.
+
+struct MemorySample {
+    size_t peak_rss_bytes;
+    size_t rss_growth_bytes;
+    long minor_faults;
+    long major_faults;
+};
+
+struct MemoryProbe {
+    int clear_refs_fd;
+    size_t start_rss_bytes;
+    long start_minor_faults;
+    long start_major_faults;
+
+    MemoryProbe();
+    ~MemoryProbe();
+
+    MemoryProbe(const MemoryProbe&) = delete;
+    MemoryProbe& operator=(const MemoryProbe&) = delete;
+
+    bool is_peak_per_run() const {
+        return clear_refs_fd != -1;
+    }
+
+    void start();
+    MemorySample stop();
+};
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// Integer parsing shared by the solutions. Numbers are parsed eight digits at a
+// time using SWAR (SIMD within a register): eight ASCII digits are loaded into a
+// 64-bit word, and three multiply-and-shift steps combine pairs of digits, then
+// pairs of pairs, and finally the two 4-digit halves, instead of one multiply
+// per digit. Fields are split by scanning eight bytes at a time for the delim-
+// iter, so that a line with several fields is split in a single pass, rather
+// than with one `find()` per field followed by a `substr()` per field.
+//
+// Loads never read beyond the end of the string view, since lines need not be
+// followed by readable memory: the leading (partial) group of digits and the
+// tail of the delimiter scan are copied or scanned byte by byte. All functions
+// are constexpr, and fall back to plain loops in constant evaluation (so that
+// they can also solve embedded inputs, see 'embedded.hpp') and on big-endian
+// targets. Numbers are expected to consist of digits only (with an optional
+// leading minus sign), and to have at most 18 digits. Every group of eight bytes
+// is checked for digits before it is combined, and if any group fails the check
+// (e.g. because of the '\r' of a CRLF line ending), the number is parsed again
+// with `std::from_chars`, which stops at the first non-digit.
+
+const uint64_t SWAR_ONES = 0x0101010101010101;
+const uint64_t SWAR_ZEROS = SWAR_ONES * '0';
+
+constexpr bool use_swar() {
+    return !std::is_constant_evaluated() && std::endian::native == std::endian::little;
+}
+
+// Check that all eight bytes of a word are ASCII digits: the high nibble of every
+// byte must be 3, and adding 6 must not carry into the high nibble, i.e. the low
+// nibble must be at most 9. Carries between bytes only occur for bytes of 0xFA
+// and up, which already fail the first test.
+
+constexpr bool is_eight_digits(uint64_t word) {
+    uint64_t high_nibbles = word & (SWAR_ONES * 0xF0);
+    uint64_t adjusted_high_nibbles = (word + SWAR_ONES * 0x06) & (SWAR_ONES * 0xF0);
+    return (high_nibbles | (adjusted_high_nibbles >> 4)) == SWAR_ONES * 0x33;
+}
+
+// Combine eight digits (the first digit in the lowest byte, each byte already
+// reduced to its value 0-9) into their numeric value.
+
+constexpr uint64_t combine_eight_digits(uint64_t digits) {
+    digits = (digits * 10 + (digits >> 8)) & 0x00FF00FF00FF00FF;
+    digits = (digits * 100 + (digits >> 16)) & 0x0000FFFF0000FFFF;
+    return (digits * 10000 + (digits >> 32)) & 0x00000000FFFFFFFF;
+}
+
+// Load up to eight digits. Shorter numbers are right-aligned in a word that is
+// filled with '0' characters, so that they acquire leading zeros.
+
+inline uint64_t load_up_to_eight_digits(const char* data, size_t size) {
+    uint64_t word = SWAR_ZEROS;
+    std::memcpy(reinterpret_cast<char*>(&word) + (8 - size), data, size);
+    return word;
+}
+
+// Parse a string of digits, e.g. '12345', to an unsigned value. The digit checks
+// of all groups are combined, so that there is a single branch per number.
+
+constexpr uint64_t parse_digits(std::string_view digits) {
+    if (!use_swar()) {
+        uint64_t value = 0;
+
+        for (char digit : digits) {
+            if (digit < '0' || digit > '9') {
+                break;
+            }
+
+            value = value * 10 + (uint64_t) (digit - '0');
+        }
+
+        return value;
+    }
+
+    size_t leading_size = digits.size() % 8;
+    uint64_t value = 0;
+    bool all_digits = true;
+
+    if (leading_size > 0) {
+        uint64_t word = load_up_to_eight_digits(digits.data(), leading_size);
+        all_digits &= is_eight_digits(word);
+        value = combine_eight_digits(word - SWAR_ZEROS);
+    }
+
+    for (size_t position = leading_size; position < digits.size(); position += 8) {
+        uint64_t word;
+        std::memcpy(&word, digits.data() + position, 8);
+        all_digits &= is_eight_digits(word);
+        value = value * 100000000 + combine_eight_digits(word - SWAR_ZEROS);
+    }
+
+    if (!all_digits) {
+        value = 0;
+        std::from_chars(digits.data(), digits.data() + digits.size(), value);
+    }
+
+    return value;
+}
+
+// Parse a number with an optional leading minus sign to a long.
+
+constexpr long parse_long(std::string_view number) {
+    if (!number.empty() && number.front() == '-') {
+        return -(long) parse_digits(number.substr(1));
+    }
+
+    return (long) parse_digits(number);
+}
+
+// Find the first occurrence of `delimiter` at or after `position`, or return the
+// size of the string if there is none. Bytes equal to the delimiter become zero
+// after the XOR, and the classic "has zero byte" expression then sets the high
+// bit of every zero byte; bytes above the first zero byte may be flagged falsely,
+// but the lowest flagged byte is always exact.
+
+constexpr size_t find_delimiter(std::string_view text, char delimiter, size_t position) {
+    if (use_swar()) {
+        uint64_t pattern = SWAR_ONES * (uint8_t) delimiter;
+
+        for (; position + 8 <= text.size(); position += 8) {
+            uint64_t word;
+            std::memcpy(&word, text.data() + position, 8);
+            word ^= pattern;
+            uint64_t matches = (word - SWAR_ONES) & ~word & (SWAR_ONES * 0x80);
+
+            if (matches != 0) {
+                return position + std::countr_zero(matches) / 8;
+            }
+        }
+    }
+
+    for (; position < text.size(); ++position) {
+        if (text[position] == delimiter) {
+            return position;
+        }
+    }
+
+    return text.size();
+}
+
+// Split a line into exactly N fields separated by `delimiter`, e.g. '1,2,3' into
+// '1', '2' and '3'. The last field extends to the end of the line.
+
+template <size_t N>
+constexpr std::array<std::string_view, N> split_fields(std::string_view line, char delimiter) {
+    std::array<std::string_view, N> fields;
+    size_t start = 0;
+
+    for (size_t index = 0; index + 1 < N; ++index) {
+        size_t end = find_delimiter(line, delimiter, start);
+        fields[index] = line.substr(start, end - start);
+        start = std::min(end + 1, line.size());
+    }
+
+    fields[N - 1] = line.substr(start);
+    return fields;
+}
+
+// Split a line into N fields, and parse every field to a long, e.g. to parse the
+// coordinates of a point with `auto [x, y] = parse_fields<2>(line, ',')`.
+
+template <size_t N>
+constexpr std::array<long, N> parse_fields(std::string_view line, char delimiter) {
+    std::array<std::string_view, N> fields = split_fields<N>(line, delimiter);
+    std::array<long, N> values;
+
+    for (size_t index = 0; index < N; ++index) {
+        values[index] = parse_long(fields[index]);
+    }
+
+    return values;
+}
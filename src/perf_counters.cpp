@@ -0,0 +1,221 @@
+#include "perf_counters.hpp"
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const std::array<const char*, COUNTER_COUNT> COUNTER_NAMES = {
+    "Cycles",
+    "Instructions",
+    "L1D misses",
+    "LLC misses",
+    "Branch misses",
+    "dTLB misses",
+};
+
+#if defined(__linux__)
+
+// Event type and config for each counter, in the same order as `CounterType`.
+// Cache events are encoded as (cache ID) | (operation << 8) | (result << 16).
+
+struct EventConfig {
+    uint32_t type;
+    uint64_t config;
+};
+
+const uint64_t READ_MISS = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+const std::array<EventConfig, COUNTER_COUNT> EVENT_CONFIGS = {
+    EventConfig { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    EventConfig { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    EventConfig { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | READ_MISS },
+    EventConfig { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | READ_MISS },
+    EventConfig { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    EventConfig { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | READ_MISS },
+};
+
+// Layout of the data returned by `read()` on the group leader, given the read
+// format flags used below (group, time enabled, time running, and IDs).
+
+struct GroupReadFormat {
+    uint64_t nr;
+    uint64_t time_enabled;
+    uint64_t time_running;
+    struct { uint64_t value; uint64_t id; } values[COUNTER_COUNT];
+};
+
+int open_event(const EventConfig& event, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = (group_fd == -1) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+// Counter groups when the counters are split, each led by its first counter.
+const std::vector<std::vector<size_t>> SPLIT_GROUPS = {
+    { Cycles, Instructions },
+    { L1DMisses, LLCMisses, BranchMisses, DTLBMisses },
+};
+
+// Duration of the busy loop that checks whether the full group gets scheduled.
+const std::chrono::milliseconds PROBE_DURATION = std::chrono::milliseconds(2);
+
+// Open the counters as one group, or as the split groups. The first counter of
+// every group that can be opened becomes its leader, and the other counters are
+// added to its group. A failure to open the cycles counter (which always leads
+// the first group) disables counters altogether, and leaves `errno` set; other
+// failures only disable those counters.
+
+void PerfCounters::open_groups(bool split) {
+    close_groups();
+    is_split = split;
+    std::vector<std::vector<size_t>> groups = SPLIT_GROUPS;
+
+    if (!split) {
+        groups = { { Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses, DTLBMisses } };
+    }
+
+    for (const std::vector<size_t>& group : groups) {
+        int leader_fd = -1;
+
+        for (size_t counter : group) {
+            fds[counter] = open_event(EVENT_CONFIGS[counter], leader_fd);
+
+            if (fds[counter] == -1) {
+                if (counter == Cycles) {
+                    return;
+                }
+
+                continue;
+            }
+
+            ioctl(fds[counter], PERF_EVENT_IOC_ID, &ids[counter]);
+
+            if (leader_fd == -1) {
+                leader_fd = fds[counter];
+                leader_fds.push_back(leader_fd);
+            }
+        }
+    }
+}
+
+void PerfCounters::close_groups() {
+    for (int& fd : fds) {
+        if (fd != -1) {
+            close(fd);
+            fd = -1;
+        }
+    }
+
+    leader_fds.clear();
+}
+
+PerfCounters::PerfCounters() : ids {}, is_split(false) {
+    fds.fill(-1);
+    open_groups(false);
+
+    if (!is_available()) {
+        bool is_permission_error = (errno == EACCES || errno == EPERM);
+        error = std::string("perf_event_open: ") + std::strerror(errno);
+        error += is_permission_error ? " (check /proc/sys/kernel/perf_event_paranoid)" : "";
+        close_groups();
+        return;
+    }
+
+    // Probe whether the full group gets scheduled at all; if not, `stop()` splits it.
+    start();
+    auto start_time = std::chrono::steady_clock::now();
+
+    while (std::chrono::steady_clock::now() - start_time < PROBE_DURATION) {}
+
+    stop();
+}
+
+PerfCounters::~PerfCounters() {
+    close_groups();
+}
+
+void PerfCounters::start() {
+    for (int leader_fd : leader_fds) {
+        ioctl(leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+// Stop the groups and read the counters of every group at once. If the kernel
+// had to multiplex a group with other events, its time running is less than its
+// time enabled, and we scale its values accordingly. If the full group was not
+// scheduled, the counters are split for all following runs.
+
+CounterSample PerfCounters::stop() {
+    for (int leader_fd : leader_fds) {
+        ioctl(leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    CounterSample sample {};
+
+    for (int leader_fd : leader_fds) {
+        GroupReadFormat data {};
+
+        if (read(leader_fd, &data, sizeof(data)) <= 0 || data.time_running == 0) {
+            continue;
+        }
+
+        double scale = (double) data.time_enabled / (double) data.time_running;
+
+        for (uint64_t index = 0; index < data.nr; ++index) {
+            for (size_t counter = 0; counter < COUNTER_COUNT; ++counter) {
+                if (fds[counter] != -1 && ids[counter] == data.values[index].id) {
+                    sample.values[counter] = (double) data.values[index].value * scale;
+                    sample.is_counted[counter] = true;
+                }
+            }
+        }
+    }
+
+    sample.is_scheduled = sample.is_counted[Cycles];
+
+    if (!sample.is_scheduled && !is_split) {
+        open_groups(true);
+        note = "the six counters were never scheduled together, so they are counted in two groups "
+            "(cycles and instructions, and the cache and branch events)";
+    }
+
+    return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters() : ids {}, is_split(false) {
+    fds.fill(-1);
+    error = "hardware counters require perf_event_open() (Linux only)";
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+
+CounterSample PerfCounters::stop() {
+    return CounterSample {};
+}
+
+#endif
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Hardware performance counters, read through a single `perf_event_open()` group
+// so that all counters cover exactly the same instructions. Counters that the
+// CPU or the kernel does not support are skipped individually; if not even the
+// group leader (cycles) can be opened, e.g. because `perf_event_paranoid` does
+// not allow it or because we're not running on Linux, `is_available()` returns
+// false, and `error` describes why.
+//
+// A group is only counted while all of its events fit on the PMU at once, so a
+// group of six events may never be scheduled on CPUs with few counter slots (or
+// when the NMI watchdog occupies one). We check this with a short probe when the
+// counters are opened, and again after every run: if the group was not scheduled,
+// the counters are reopened as two smaller groups, cycles and instructions, and
+// the cache and branch events, which the kernel multiplexes and scales separately.
+// `note` then describes the split. Only the calling thread is counted, not the
+// workers of the thread pool (see 'thread_pool.hpp').
+
+const size_t COUNTER_COUNT = 6;
+
+enum CounterType { Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses, DTLBMisses };
+
+extern const std::array<const char*, COUNTER_COUNT> COUNTER_NAMES;
+
+// Counter values for a single run. Values of counters that could not be opened
+// are left at zero; values of multiplexed counters are scaled up to the full
+// running time of their group. If a group was never scheduled on the PMU during
+// the run (e.g. because other events occupied all counter slots, or under some
+// hypervisors), or could not be read, its counters are not counted, and their
+// values are zero; such values carry no measurement, and must not be averaged
+// in. `is_scheduled` tells whether the cycles were counted.
+
+struct CounterSample {
+    std::array<double, COUNTER_COUNT> values;
+    std::array<bool, COUNTER_COUNT> is_counted;
+    bool is_scheduled;
+
+    double ipc() const {
+        return values[Cycles] > 0.0 ? values[Instructions] / values[Cycles] : 0.0;
+    }
+};
+
+struct PerfCounters {
+    std::array<int, COUNTER_COUNT> fds;
+    std::array<uint64_t, COUNTER_COUNT> ids;
+    std::vector<int> leader_fds;
+    bool is_split;
+    std::string error;
+    std::string note;
+
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool is_available() const {
+        return fds[Cycles] != -1;
+    }
+
+    bool is_open(size_t counter) const {
+        return fds[counter] != -1;
+    }
+
+    void start();
+    CounterSample stop();
+
+    void open_groups(bool split);
+    void close_groups();
+};
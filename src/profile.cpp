@@ -0,0 +1,417 @@
+#include "profile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "allocations.hpp"
+#include "build_flavour.hpp"
+#include "cache_eviction.hpp"
+#include "input.hpp"
+#include "memory_usage.hpp"
+#include "perf_counters.hpp"
+#include "report.hpp"
+#include "solution.hpp"
+#include "solve_context.hpp"
+#include "statistics.hpp"
+#include "stream.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+
+// Add the trace events of a single run to the profile result, and sum their
+// durations per phase name. Events are recorded when their scope ends, so we
+// sort them by start time first, in order to keep phases in order of entry.
+
+void add_trace_events(ProfileResult& result, std::vector<TraceEvent> events) {
+    std::ranges::sort(events, {}, &TraceEvent::start_ns);
+    std::vector<std::pair<std::string, double>> run_totals;
+
+    for (const TraceEvent& event : events) {
+        auto iter = std::ranges::find(run_totals, event.name, [](const auto& total) { return total.first; });
+
+        if (iter == run_totals.end()) {
+            run_totals.emplace_back(event.name, 0.0);
+            iter = run_totals.end() - 1;
+        }
+
+        iter->second += (double) event.duration_ns / 1000.0;
+        result.trace_events.push_back(event);
+    }
+
+    for (const auto& [name, total_us] : run_totals) {
+        auto iter = std::ranges::find(result.phases, name, &PhaseSamples::name);
+
+        if (iter == result.phases.end()) {
+            result.phases.push_back(PhaseSamples { name, {} });
+            iter = result.phases.end() - 1;
+        }
+
+        iter->samples_us.push_back(total_us);
+    }
+}
+
+// Run the solution once and return the elapsed time in microseconds. If hardware
+// counters are enabled, they are started before and stopped after the timed part,
+// so that the overhead of the counter system calls is not included in the timing.
+// The same goes for the memory probe, and for resetting the arena of the solve
+// context, which releases the memory allocated by the previous run. If tracing
+// is enabled, the trace events recorded during the run are collected afterwards.
+
+double time_solution(
+    const Solver& solve,
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    ProfileResult& result,
+    SolveContext& context,
+    PerfCounters* counters,
+    MemoryProbe& memory_probe
+) {
+    context.reset();
+    memory_probe.start();
+
+    if (counters != nullptr) {
+        counters->start();
+    }
+
+    int64_t trace_start_ns = is_tracing_enabled() ? trace_now_ns() : 0;
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    result.solution = solve(lines, input_name, context);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+
+    if (is_tracing_enabled()) {
+        int64_t trace_duration_ns = trace_now_ns() - trace_start_ns;
+        result.trace_events.push_back(TraceEvent { "solve", trace_start_ns, trace_duration_ns, get_trace_thread_index() });
+        add_trace_events(result, take_trace_events());
+    }
+
+    if (counters != nullptr) {
+        result.counter_samples.push_back(counters->stop());
+    }
+
+    result.memory_samples.push_back(memory_probe.stop());
+    return (double) duration_ns.count() / 1000.0;
+}
+
+ProfileResult profile_solution(
+    const Solver& solve,
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    const ProfileOptions& options
+) {
+    ProfileResult result {};
+    SolveContext context;
+    MemoryProbe memory_probe;
+    std::optional<PerfCounters> perf_counters;
+    PerfCounters* counters = nullptr;
+
+    if (options.use_counters) {
+        perf_counters.emplace();
+
+        if (perf_counters->is_available()) {
+            counters = &perf_counters.value();
+        } else {
+            result.counter_error = perf_counters->error;
+        }
+    }
+
+    // Besides warming up the caches, the warm-up runs grow the arena of the solve
+    // context to the size needed by the solution.
+    for (int i = 0; i < options.warmup_runs; ++i) {
+        context.reset();
+        memory_probe.start();
+        result.solution = solve(lines, input_name, context);
+        MemorySample memory_sample = memory_probe.stop();
+
+        if (i == 0) {
+            result.first_run_memory = memory_sample;
+        }
+    }
+
+    set_tracing_enabled(options.use_tracing);
+
+    if (options.budget_ms > 0.0) {
+        double budget_us = options.budget_ms * 1000.0;
+        double total_us = 0.0;
+
+        // Always take at least two samples, so that we can compute a spread.
+        while (total_us < budget_us || result.samples_us.size() < 2) {
+            double duration_us = time_solution(solve, lines, input_name, result, context, counters, memory_probe);
+            result.samples_us.push_back(duration_us);
+            total_us += duration_us;
+        }
+    } else {
+        result.samples_us.reserve(options.runs);
+
+        for (int i = 0; i < options.runs; ++i) {
+            result.samples_us.push_back(time_solution(solve, lines, input_name, result, context, counters, memory_probe));
+        }
+    }
+
+    set_tracing_enabled(false);
+
+    if (counters != nullptr) {
+        result.counter_note = counters->note;
+    }
+
+    if (options.warmup_runs == 0 && !result.memory_samples.empty()) {
+        result.first_run_memory = result.memory_samples.front();
+    }
+
+    result.is_peak_rss_per_run = memory_probe.is_peak_per_run();
+
+    // Count allocations in one additional, untimed run, so that the overhead of
+    // the counting itself does not affect the timings. Solutions are determin-
+    // istic, so the counts of this run are representative of all other runs.
+    context.reset();
+    start_allocation_tracking();
+    result.solution = solve(lines, input_name, context);
+    result.allocations = stop_allocation_tracking();
+    result.arena_bytes = context.buffer.size();
+
+    result.statistics = Statistics::compute(result.samples_us);
+    return result;
+}
+
+ProfileResult profile_cold_solution(
+    const Solver& solve,
+    const std::string& filename,
+    const std::string& input_name,
+    const ProfileOptions& options,
+    bool evict_page_cache
+) {
+    ProfileResult result {};
+    result.phases = { PhaseSamples { "read input", {} }, PhaseSamples { "split lines", {} } };
+    double total_us = 0.0;
+
+    auto is_done = [&]() {
+        if (options.budget_ms > 0.0) {
+            return total_us >= options.budget_ms * 1000.0 && result.samples_us.size() >= 2;
+        }
+
+        return result.samples_us.size() >= (size_t) options.runs;
+    };
+
+    while (!is_done()) {
+        if (evict_page_cache) {
+            evict_file_cache(filename);
+        }
+
+        InputTimings input_timings {};
+        InputFile input_file(filename, &input_timings);
+        SolveContext context;
+        evict_cpu_caches();
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        result.solution = solve(input_file.lines, input_name, context);
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        double duration_us = std::chrono::duration<double, std::micro>(end_time - start_time).count();
+        result.samples_us.push_back(duration_us);
+        result.phases[0].samples_us.push_back(input_timings.read_us);
+        result.phases[1].samples_us.push_back(input_timings.split_us);
+        total_us += duration_us;
+    }
+
+    result.statistics = Statistics::compute(result.samples_us);
+    return result;
+}
+
+// Print the mean and minimum value per run of each hardware counter, plus the
+// mean number of instructions per cycle. Counters that were not available on
+// this machine are omitted, and runs in which a counter was not scheduled are
+// excluded from the means of that counter; runs without cycles are reported
+// separately. Since only the calling thread is counted, we point out that the
+// counts are partial when the pool has other threads.
+
+void print_counter_samples(const std::vector<CounterSample>& samples, const std::string& note) {
+    std::array<double, COUNTER_COUNT> totals {};
+    std::array<double, COUNTER_COUNT> minimums {};
+    std::array<size_t, COUNTER_COUNT> counted_counts {};
+    minimums.fill(std::numeric_limits<double>::max());
+    double ipc_total = 0.0;
+    size_t ipc_count = 0;
+    size_t scheduled_count = 0;
+
+    for (const CounterSample& sample : samples) {
+        scheduled_count += sample.is_scheduled ? 1 : 0;
+
+        for (size_t counter = 0; counter < COUNTER_COUNT; ++counter) {
+            if (sample.is_counted[counter]) {
+                totals[counter] += sample.values[counter];
+                minimums[counter] = std::min(minimums[counter], sample.values[counter]);
+                counted_counts[counter] += 1;
+            }
+        }
+
+        if (sample.is_counted[Cycles] && sample.is_counted[Instructions]) {
+            ipc_total += sample.ipc();
+            ipc_count += 1;
+        }
+    }
+
+    if (!note.empty()) {
+        std::println("Hardware counters: {}", note);
+    }
+
+    if (get_thread_pool().thread_count() > 1) {
+        std::println("Hardware counters only count the calling thread, not the other {} pool threads (use THREADS=1 to count all work)",
+            get_thread_pool().thread_count() - 1);
+    }
+
+    if (scheduled_count < samples.size()) {
+        std::println("Hardware counters not scheduled in {} of {} runs", samples.size() - scheduled_count, samples.size());
+    }
+
+    if (scheduled_count == 0) {
+        return;
+    }
+
+    std::println("Counters per run (mean / min):");
+
+    for (size_t counter = 0; counter < COUNTER_COUNT; ++counter) {
+        if (totals[counter] > 0.0) {
+            double mean = totals[counter] / (double) counted_counts[counter];
+            std::string coverage = (counted_counts[counter] < samples.size())
+                ? std::format(" ({} of {} runs)", counted_counts[counter], samples.size()) : "";
+            std::println("  {:<14} {:>14.0f} / {:.0f}{}", COUNTER_NAMES[counter], mean, minimums[counter], coverage);
+        }
+    }
+
+    if (ipc_count > 0) {
+        std::println("  {:<14} {:>14.2f}", "IPC", ipc_total / (double) ipc_count);
+    }
+}
+
+// Print the mean and minimum time per run of each traced phase, plus its share
+// of the mean runtime of the solution. Nested phases are included in the time
+// of their parent phase as well, so shares do not necessarily add up to 100%.
+
+void print_phase_samples(const std::vector<PhaseSamples>& phases, double mean_us) {
+    std::println("Phases per run (mean / min):");
+
+    for (const PhaseSamples& phase : phases) {
+        double mean = std::ranges::fold_left(phase.samples_us, 0.0, std::plus<>()) / (double) phase.samples_us.size();
+        double minimum = std::ranges::min(phase.samples_us);
+        double share = mean_us > 0.0 ? 100.0 * mean / mean_us : 0.0;
+        std::println("  {:<20} {:>12.2f} / {:.2f} μs ({:.1f}%)", phase.name, mean, minimum, share);
+    }
+}
+
+// Print the peak heap usage of a run, and the median peak RSS, RSS growth and page
+// faults per timed run, followed by the same for the first run of the session,
+// which is the one that actually has to grow the heap and the arena.
+
+void print_memory_samples(const ProfileResult& result) {
+    auto get_median = [&](auto get_value) {
+        std::vector<double> values;
+
+        for (const MemorySample& sample : result.memory_samples) {
+            values.push_back((double) std::invoke(get_value, sample));
+        }
+
+        std::ranges::sort(values);
+        return (long) percentile(values, 0.5);
+    };
+
+    const MemorySample& first = result.first_run_memory;
+    std::string peak_scope = result.is_peak_rss_per_run ? "" : " (process lifetime)";
+
+    std::println("Memory per run (median): peak heap {} bytes ({} live, {} arena)",
+        format_thousands((long) get_peak_heap_bytes(result)),
+        format_thousands((long) result.allocations.peak_live_bytes),
+        format_thousands((long) result.arena_bytes));
+    std::println("  {:<14} {:>14} bytes{}", "Peak RSS", format_thousands(get_median(&MemorySample::peak_rss_bytes)), peak_scope);
+    std::println("  {:<14} {:>14} bytes (first run {})", "RSS growth",
+        format_thousands(get_median(&MemorySample::rss_growth_bytes)), format_thousands((long) first.rss_growth_bytes));
+    std::println("  {:<14} {:>14} (first run {})", "Minor faults",
+        format_thousands(get_median(&MemorySample::minor_faults)), format_thousands(first.minor_faults));
+    std::println("  {:<14} {:>14} (first run {})", "Major faults",
+        format_thousands(get_median(&MemorySample::major_faults)), format_thousands(first.major_faults));
+}
+
+void print_profile_result(const ProfileResult& result) {
+    const Statistics& stats = result.statistics;
+
+    std::println("Solution: {}", stringify(result.solution));
+    std::println("Build:    {}", BUILD_FLAVOUR);
+    std::println("Threads:  {}", get_thread_pool().thread_count());
+    std::println("Runs:     {} ({} outliers rejected)", stats.count, stats.outliers);
+    std::println("Mean:     {:10.2f} μs (95% CI {:.2f} - {:.2f} μs)", stats.mean, stats.ci_low, stats.ci_high);
+    std::println("Stddev:   {:10.2f} μs", stats.stddev);
+    std::println("Min:      {:10.2f} μs", stats.min);
+    std::println("Median:   {:10.2f} μs", stats.median);
+    std::println("P90:      {:10.2f} μs", stats.p90);
+    std::println("P99:      {:10.2f} μs", stats.p99);
+
+    const AllocationStats& allocations = result.allocations;
+    std::println("Allocations per run: {} ({} frees, {} bytes, peak {} bytes live)",
+        format_thousands(allocations.allocations),
+        format_thousands(allocations.frees),
+        format_thousands(allocations.bytes_allocated),
+        format_thousands(allocations.peak_live_bytes));
+    print_memory_samples(result);
+
+    if (!result.phases.empty()) {
+        print_phase_samples(result.phases, stats.mean);
+    } else if (!result.trace_events.empty()) {
+        std::println("No phases traced; build with TRACE=1 to enable trace scopes");
+    }
+
+    if (!result.counter_samples.empty()) {
+        print_counter_samples(result.counter_samples, result.counter_note);
+    } else if (!result.counter_error.empty()) {
+        std::println("Hardware counters unavailable: {}", result.counter_error);
+    }
+}
+
+// Print one row of the cold profile table: the warm and cold values of a single
+// statistic, the absolute gap between them, and the slowdown factor.
+
+void print_cold_row(const std::string& name, double warm_us, double cold_us) {
+    double factor = warm_us > 0.0 ? cold_us / warm_us : 0.0;
+    std::println("{:<8} {:>12.2f} {:>12.2f} {:>+12.2f}   {:.2f}x", name, warm_us, cold_us, cold_us - warm_us, factor);
+}
+
+void print_cold_profile_result(const ProfileResult& warm, const ProfileResult& cold) {
+    size_t cache_size = get_last_level_cache_size();
+    assert(stringify(warm.solution) == stringify(cold.solution) && "cold runs produced a different solution");
+
+    std::println("Solution: {}", stringify(warm.solution));
+    std::println("Build:    {}", BUILD_FLAVOUR);
+    std::println("Threads:  {}", get_thread_pool().thread_count());
+    std::println("LLC:      {} KB (sweeping {} KB before every cold run)",
+        format_thousands((long) (cache_size / 1024)), format_thousands((long) (cache_size * EVICTION_BUFFER_FACTOR / 1024)));
+    std::println("Runs:     {} warm ({} outliers rejected), {} cold ({} outliers rejected)",
+        warm.statistics.count, warm.statistics.outliers, cold.statistics.count, cold.statistics.outliers);
+    std::println("");
+    std::println("{:<8} {:>12} {:>12} {:>12}   {}", "(μs)", "Warm", "Cold", "Gap", "Factor");
+    print_cold_row("Min", warm.statistics.min, cold.statistics.min);
+    print_cold_row("Median", warm.statistics.median, cold.statistics.median);
+    print_cold_row("Mean", warm.statistics.mean, cold.statistics.mean);
+    print_cold_row("P90", warm.statistics.p90, cold.statistics.p90);
+    print_cold_row("P99", warm.statistics.p99, cold.statistics.p99);
+    print_cold_row("Max", warm.statistics.max, cold.statistics.max);
+    std::println("");
+    std::println("Input loading per cold run, not included above (mean / min):");
+
+    for (const PhaseSamples& phase : cold.phases) {
+        double mean = std::ranges::fold_left(phase.samples_us, 0.0, std::plus<>()) / (double) phase.samples_us.size();
+        std::println("  {:<20} {:>12.2f} / {:.2f} μs", phase.name, mean, std::ranges::min(phase.samples_us));
+    }
+}
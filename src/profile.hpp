@@ -0,0 +1,102 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "allocations.hpp"
+#include "memory_usage.hpp"
+#include "perf_counters.hpp"
+#include "solution.hpp"
+#include "solve_context.hpp"
+#include "statistics.hpp"
+#include "trace.hpp"
+
+// Options controlling a profiling session. If `budget_ms` is positive, we keep
+// running the solution until the total measured time exceeds this budget, and
+// `runs` is ignored; otherwise, we perform exactly `runs` timed runs. Warm-up
+// runs are executed before the timed runs, and their timings are discarded. If
+// `use_counters` is set, every timed run is also wrapped in a group of hardware
+// performance counters (see 'perf_counters.hpp'). If `use_tracing` is set, trace
+// events of the timed runs are collected and aggregated per phase (see 'trace.hpp').
+
+struct ProfileOptions {
+    int warmup_runs;
+    int runs;
+    double budget_ms;
+    bool use_counters;
+    bool use_tracing;
+};
+
+// Total time spent in one traced phase, in microseconds, for each timed run in
+// which the phase occurred.
+
+struct PhaseSamples {
+    std::string name;
+    std::vector<double> samples_us;
+};
+
+// Result of a profiling session. Samples are stored in microseconds, in the
+// order in which they were measured, i.e. before outlier rejection. Counter
+// samples (if enabled and available) and memory samples are stored in the same
+// order; the counter note says whether the counter group had to be split. The first run of the session (i.e. the first warm-up run, if any) is
+// the only one that starts without a warm heap and arena, so its memory sample
+// is kept separately. Allocation statistics are those of a single run, and the
+// arena size is the size of the arena buffer of the solve context after the
+// last run, i.e. the arena's high-water mark. Trace events include one 'solve'
+// event per timed run, which encloses the phase events of that run.
+
+struct ProfileResult {
+    Solution solution;
+    std::vector<double> samples_us;
+    Statistics statistics;
+    std::vector<CounterSample> counter_samples;
+    std::string counter_error;
+    std::string counter_note;
+    std::vector<MemorySample> memory_samples;
+    MemorySample first_run_memory;
+    bool is_peak_rss_per_run;
+    AllocationStats allocations;
+    size_t arena_bytes;
+    std::vector<PhaseSamples> phases;
+    std::vector<TraceEvent> trace_events;
+};
+
+ProfileResult profile_solution(
+    const Solver& solve,
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    const ProfileOptions& options
+);
+
+// Profile a solution on cold caches. Before every timed run, the input file is
+// mapped again (after dropping it from the page cache, if requested), a fresh
+// solve context is created, and the CPU caches are evicted (see 'cache_evic-
+// tion.hpp'), so that every run resembles the single run of a new process on
+// a new input, apart from process startup itself. The samples only cover the
+// solve; reading the input (opening and mapping it, and faulting in its pages,
+// from the disk if it was dropped from the page cache) and splitting it into
+// lines are timed separately, as the two phases of the result. There are no
+// warm-up runs, and allocations, counters and traces are not collected.
+
+ProfileResult profile_cold_solution(
+    const Solver& solve,
+    const std::string& filename,
+    const std::string& input_name,
+    const ProfileOptions& options,
+    bool evict_page_cache
+);
+
+// Peak heap usage of a single run: the peak number of live bytes allocated from
+// the heap, plus the bytes reserved for the arena.
+
+inline size_t get_peak_heap_bytes(const ProfileResult& result) {
+    return result.allocations.peak_live_bytes + result.arena_bytes;
+}
+
+void print_profile_result(const ProfileResult& result);
+
+// Print the statistics of warm runs (as measured by `profile_solution()`) and
+// cold runs side by side, together with the gap between them.
+
+void print_cold_profile_result(const ProfileResult& warm, const ProfileResult& cold);
@@ -0,0 +1,156 @@
+#include "regression.hpp"
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+#include "statistics.hpp"
+
+// Maximum p-value at which a change in runtime is considered significant. This
+// is deliberately strict, since a false alarm fails the check.
+
+const double SIGNIFICANCE_LEVEL = 0.01;
+
+double get_median(const std::vector<double>& samples) {
+    std::vector<double> sorted = samples;
+    std::ranges::sort(sorted);
+    return percentile(sorted, 0.5);
+}
+
+// Convert samples to a JSON object, with one entry per solution containing the
+// median (for readability), all samples (for the statistical test), and the
+// peak heap usage.
+
+JsonValue format_baseline_json(const BaselineSamples& samples, const BaselinePeakHeap& peak_heap, const std::string& input_name) {
+    JsonValue json = JsonValue::make_object();
+    json.set("input", JsonValue::make_string(input_name));
+    JsonValue& results = json.set("results", JsonValue::make_object());
+
+    for (const auto& [day_part, solution_samples] : samples) {
+        JsonValue entry = JsonValue::make_object();
+        entry.set("median_us", JsonValue::make_number(get_median(solution_samples)));
+
+        if (peak_heap.contains(day_part)) {
+            entry.set("peak_heap_bytes", JsonValue::make_number((double) peak_heap.at(day_part)));
+        }
+
+        JsonValue& samples_array = entry.set("samples_us", JsonValue::make_array());
+
+        for (double sample : solution_samples) {
+            samples_array.array.push_back(JsonValue::make_number(sample));
+        }
+
+        results.set(day_part, entry);
+    }
+
+    return json;
+}
+
+// Get the samples of one solution from a baseline in the format produced by
+// `format_baseline_json()`, or an empty vector if the solution is not in it.
+
+std::vector<double> get_baseline_samples(const JsonValue& baseline, const std::string& day_part) {
+    std::vector<double> samples;
+    const JsonValue* results = baseline.find("results");
+    const JsonValue* entry = results != nullptr ? results->find(day_part) : nullptr;
+    const JsonValue* samples_array = entry != nullptr ? entry->find("samples_us") : nullptr;
+
+    if (samples_array != nullptr) {
+        for (const JsonValue& sample : samples_array->array) {
+            samples.push_back(sample.number);
+        }
+    }
+
+    return samples;
+}
+
+// Get the peak heap usage of one solution from a baseline, or zero if the solution
+// is not in it, or if the baseline does not include heap usage.
+
+size_t get_baseline_peak_heap_bytes(const JsonValue& baseline, const std::string& day_part) {
+    const JsonValue* results = baseline.find("results");
+    const JsonValue* entry = results != nullptr ? results->find(day_part) : nullptr;
+    const JsonValue* peak_heap = entry != nullptr ? entry->find("peak_heap_bytes") : nullptr;
+    return peak_heap != nullptr ? (size_t) peak_heap->number : 0;
+}
+
+// Get the number of threads of the pool with which a baseline was recorded, or
+// zero if the baseline does not include it.
+
+size_t get_baseline_thread_count(const JsonValue& baseline) {
+    const JsonValue* thread_count = baseline.find("threads");
+    return thread_count != nullptr ? (size_t) thread_count->number : 0;
+}
+
+RegressionCheck check_regression(
+    const std::string& day_part,
+    const std::vector<double>& baseline_samples,
+    const std::vector<double>& current_samples,
+    size_t baseline_peak_heap_bytes,
+    size_t current_peak_heap_bytes,
+    double threshold_percent
+) {
+    RegressionCheck check {
+        day_part, 0.0, 0.0, 0.0, 1.0, false, false,
+        baseline_peak_heap_bytes, current_peak_heap_bytes, 0.0, false
+    };
+    check.baseline_median_us = get_median(baseline_samples);
+    check.current_median_us = get_median(current_samples);
+
+    if (check.baseline_median_us > 0.0) {
+        check.change_percent = 100.0 * (check.current_median_us / check.baseline_median_us - 1.0);
+    }
+
+    if (check.change_percent > threshold_percent) {
+        check.p_value = mann_whitney_p_value(baseline_samples, current_samples);
+        check.is_regression = check.p_value < SIGNIFICANCE_LEVEL;
+    } else if (check.change_percent < -threshold_percent) {
+        check.p_value = mann_whitney_p_value(current_samples, baseline_samples);
+        check.is_improvement = check.p_value < SIGNIFICANCE_LEVEL;
+    } else {
+        double p_slower = mann_whitney_p_value(baseline_samples, current_samples);
+        double p_faster = mann_whitney_p_value(current_samples, baseline_samples);
+        check.p_value = std::min(p_slower, p_faster);
+    }
+
+    if (baseline_peak_heap_bytes > 0) {
+        check.heap_change_percent = 100.0 * ((double) current_peak_heap_bytes / (double) baseline_peak_heap_bytes - 1.0);
+        check.is_memory_regression = check.heap_change_percent > threshold_percent;
+    }
+
+    return check;
+}
+
+// Format the checks as a plain-text table, with one row per solution, ending with
+// a summary line. Regressed solutions are marked so that they stand out. The heap
+// change is left empty for solutions without a peak heap in the baseline.
+
+std::string format_regression_table(const std::vector<RegressionCheck>& checks) {
+    std::string output = std::format("{:<6}{:>16}{:>16}{:>10}{:>10}{:>14}  {}\n",
+        "Task", "Baseline (μs)", "Current (μs)", "Change", "p-value", "Heap change", "Verdict");
+    size_t regression_count = 0;
+
+    for (const RegressionCheck& check : checks) {
+        std::string verdict = check.is_regression ? "REGRESSION" : check.is_improvement ? "improved" : "ok";
+        std::string heap_change = check.baseline_peak_heap_bytes > 0 ? std::format("{:+.1f}%", check.heap_change_percent) : "";
+        regression_count += (check.is_regression || check.is_memory_regression) ? 1 : 0;
+
+        if (check.is_memory_regression) {
+            verdict = check.is_regression ? "REGRESSION, MEMORY REGRESSION" : "MEMORY REGRESSION";
+        }
+
+        output += std::format("{:<6}{:>16.2f}{:>16.2f}{:>+9.1f}%{:>10.4f}{:>14}  {}\n",
+            check.day_part,
+            check.baseline_median_us,
+            check.current_median_us,
+            check.change_percent,
+            check.p_value,
+            heap_change,
+            verdict);
+    }
+
+    output += std::format("\n{} of {} solutions regressed\n", regression_count, checks.size());
+    return output;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+
+// Raw timing samples per solution, keyed by day and part (e.g. "09b"), as stored
+// in a baseline file.
+
+typedef std::map<std::string, std::vector<double>> BaselineSamples;
+
+// Peak heap usage per solution (in bytes, see `get_peak_heap_bytes()`), which is
+// stored next to the timing samples in a baseline file.
+
+typedef std::map<std::string, size_t> BaselinePeakHeap;
+
+// Result of comparing the timings of a solution against its baseline. A solution
+// has regressed if its median runtime increased by more than the threshold, and
+// the Mann-Whitney U test confirms that this is unlikely to be due to noise;
+// improvements are detected in the same way. Heap usage is deterministic for a
+// given thread count, so a memory regression is any increase of the peak heap
+// usage above the threshold. A peak heap of zero in the baseline (e.g. one that
+// was recorded before heap usage was stored, or at another thread count) skips
+// the memory check.
+
+struct RegressionCheck {
+    std::string day_part;
+    double baseline_median_us;
+    double current_median_us;
+    double change_percent;
+    double p_value;
+    bool is_regression;
+    bool is_improvement;
+    size_t baseline_peak_heap_bytes;
+    size_t current_peak_heap_bytes;
+    double heap_change_percent;
+    bool is_memory_regression;
+};
+
+JsonValue format_baseline_json(const BaselineSamples& samples, const BaselinePeakHeap& peak_heap, const std::string& input_name);
+
+std::vector<double> get_baseline_samples(const JsonValue& baseline, const std::string& day_part);
+
+size_t get_baseline_peak_heap_bytes(const JsonValue& baseline, const std::string& day_part);
+
+size_t get_baseline_thread_count(const JsonValue& baseline);
+
+RegressionCheck check_regression(
+    const std::string& day_part,
+    const std::vector<double>& baseline_samples,
+    const std::vector<double>& current_samples,
+    size_t baseline_peak_heap_bytes,
+    size_t current_peak_heap_bytes,
+    double threshold_percent
+);
+
+std::string format_regression_table(const std::vector<RegressionCheck>& checks);
@@ -0,0 +1,147 @@
+#include "report.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "json.hpp"
+#include "statistics.hpp"
+
+const int DAY_COUNT = 12;
+
+// Width of the part columns in the README table, i.e. the display width of the
+// "Part A (μs)" header; the 'μ' is two bytes, so we cannot use its `size()`.
+
+const size_t PART_COLUMN_WIDTH = 11;
+
+// Format an integer with a comma as the thousands separator, e.g. "35,357".
+
+std::string format_thousands(long value) {
+    std::string digits = std::to_string(std::abs(value));
+    std::string output;
+
+    for (size_t index = 0; index < digits.size(); ++index) {
+        if (index > 0 && (digits.size() - index) % 3 == 0) {
+            output += ',';
+        }
+
+        output += digits[index];
+    }
+
+    return (value < 0) ? "-" + output : output;
+}
+
+std::string pad_left(const std::string& value, size_t width) {
+    return std::string(width - std::min(width, value.size()), ' ') + value;
+}
+
+std::optional<double> get_previous_mean(const JsonValue* previous, const std::string& day_part) {
+    if (previous == nullptr) {
+        return std::nullopt;
+    }
+
+    const JsonValue* results = previous->find("results");
+    const JsonValue* entry = (results != nullptr) ? results->find(day_part) : nullptr;
+
+    if (entry == nullptr || entry->find("mean_us") == nullptr) {
+        return std::nullopt;
+    }
+
+    return entry->get_number("mean_us", 0.0);
+}
+
+std::optional<double> get_delta_percent(const Statistics& stats, const JsonValue* previous, const std::string& day_part) {
+    auto previous_mean = get_previous_mean(previous, day_part);
+
+    if (!previous_mean || *previous_mean <= 0.0) {
+        return std::nullopt;
+    }
+
+    return 100.0 * (stats.mean - *previous_mean) / *previous_mean;
+}
+
+std::string format_cell(const SweepResults& results, const JsonValue* previous, const std::string& day_part) {
+    auto iter = results.find(day_part);
+
+    if (iter == results.end()) {
+        return "";
+    }
+
+    std::string cell = format_thousands(std::lround(iter->second.mean));
+    auto delta = get_delta_percent(iter->second, previous, day_part);
+    return delta ? std::format("{} ({:+.1f}%)", cell, *delta) : cell;
+}
+
+std::string format_sweep_markdown(const SweepResults& results, const JsonValue* previous) {
+    std::vector<std::array<std::string, 2>> cells;
+    size_t width = PART_COLUMN_WIDTH;
+
+    for (int day = 1; day <= DAY_COUNT; ++day) {
+        std::string day_string = std::format("{:02}", day);
+        std::string cell_a = format_cell(results, previous, day_string + "a");
+        std::string cell_b = format_cell(results, previous, day_string + "b");
+        width = std::max({ width, cell_a.size(), cell_b.size() });
+        cells.push_back({ cell_a, cell_b });
+    }
+
+    std::string header_padding = std::string(width - PART_COLUMN_WIDTH, ' ');
+    std::string separator = std::string(width - 1, '-') + ":";
+    std::string output;
+
+    output += std::format("| Day  | {}Part A (μs) | {}Part B (μs) |\n", header_padding, header_padding);
+    output += std::format("| :--: | {} | {} |\n", separator, separator);
+
+    for (int day = 1; day <= DAY_COUNT; ++day) {
+        const auto& [cell_a, cell_b] = cells[day - 1];
+        output += std::format("|  {:02}  | {} | {} |\n", day, pad_left(cell_a, width), pad_left(cell_b, width));
+    }
+
+    return output;
+}
+
+std::string format_sweep_csv(const SweepResults& results, const JsonValue* previous) {
+    std::string output = "day,part,mean_us,median_us,min_us,p90_us,stddev_us,ci_low_us,ci_high_us,runs,delta_percent\n";
+
+    for (const auto& [day_part, stats] : results) {
+        auto delta = get_delta_percent(stats, previous, day_part);
+
+        output += std::format("{},{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{},{}\n",
+            day_part.substr(0, 2), day_part.substr(2),
+            stats.mean, stats.median, stats.min, stats.p90, stats.stddev, stats.ci_low, stats.ci_high,
+            stats.count, delta ? std::format("{:.2f}", *delta) : "");
+    }
+
+    return output;
+}
+
+JsonValue format_sweep_json(const SweepResults& results, const std::string& input_name, const JsonValue* previous) {
+    JsonValue output = JsonValue::make_object();
+    output.set("input", JsonValue::make_string(input_name));
+    JsonValue& output_results = output.set("results", JsonValue::make_object());
+
+    for (const auto& [day_part, stats] : results) {
+        JsonValue entry = JsonValue::make_object();
+        entry.set("mean_us",    JsonValue::make_number(stats.mean));
+        entry.set("median_us",  JsonValue::make_number(stats.median));
+        entry.set("min_us",     JsonValue::make_number(stats.min));
+        entry.set("p90_us",     JsonValue::make_number(stats.p90));
+        entry.set("stddev_us",  JsonValue::make_number(stats.stddev));
+        entry.set("ci_low_us",  JsonValue::make_number(stats.ci_low));
+        entry.set("ci_high_us", JsonValue::make_number(stats.ci_high));
+        entry.set("runs",       JsonValue::make_number((double) stats.count));
+
+        if (auto delta = get_delta_percent(stats, previous, day_part)) {
+            entry.set("delta_percent", JsonValue::make_number(*delta));
+        }
+
+        output_results.set(day_part, std::move(entry));
+    }
+
+    return output;
+}
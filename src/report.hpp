@@ -0,0 +1,25 @@
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "json.hpp"
+#include "statistics.hpp"
+
+// Results of a benchmark sweep, keyed by day and part (e.g. "01a").
+
+typedef std::map<std::string, Statistics> SweepResults;
+
+// Format sweep results as a Markdown table in the same layout as the results
+// table in the README (one row per day, mean runtime per part in μs), as CSV
+// with one row per solution, or as a JSON object. If the results of a previous
+// sweep are available (in the JSON format produced by `format_sweep_json()`),
+// every cell also includes the relative change of the mean compared to it.
+
+std::string format_sweep_markdown(const SweepResults& results, const JsonValue* previous);
+
+std::string format_sweep_csv(const SweepResults& results, const JsonValue* previous);
+
+JsonValue format_sweep_json(const SweepResults& results, const std::string& input_name, const JsonValue* previous);
+
+std::string format_thousands(long value);
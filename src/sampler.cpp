@@ -0,0 +1,360 @@
+#include "sampler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <print>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#if defined(__linux__)
+#include <elf.h>
+#include <link.h>
+#include <ucontext.h>
+#endif
+
+#include "report.hpp"
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define SAMPLER_SUPPORTED 1
+#endif
+
+// Number of hottest functions listed in the summary.
+const size_t SUMMARY_FUNCTION_COUNT = 5;
+
+// The profiler that the signal handler records into, and the number of handlers
+// currently running, so that the profiler is not destroyed under their feet. The
+// handler increments the count before loading the profiler, and the destructor
+// clears the profiler before loading the count. All four operations must be
+// sequentially consistent: with acquire/release only, both loads could see the
+// old values, and a handler could still write samples while (or after) they
+// are written out and freed.
+std::atomic<SamplingProfiler*> active_profiler = nullptr;
+std::atomic<int> active_handler_count = 0;
+
+// Stack bounds of the current thread (see `register_sampler_thread()`). These
+// are in static TLS, so reading them in the signal handler does not allocate.
+thread_local uintptr_t thread_stack_low = 0;
+thread_local uintptr_t thread_stack_high = 0;
+
+struct sigaction previous_action;
+
+#ifdef SAMPLER_SUPPORTED
+
+void handle_sigprof(int, siginfo_t*, void* context) {
+    int saved_errno = errno;
+    active_handler_count.fetch_add(1, std::memory_order_seq_cst);
+    SamplingProfiler* profiler = active_profiler.load(std::memory_order_seq_cst);
+
+    if (profiler != nullptr) {
+        const mcontext_t& registers = static_cast<ucontext_t*>(context)->uc_mcontext;
+#if defined(__x86_64__)
+        profiler->record(registers.gregs[REG_RIP], registers.gregs[REG_RBP], registers.gregs[REG_RSP],
+            thread_stack_low, thread_stack_high);
+#else
+        profiler->record(registers.pc, registers.regs[29], registers.sp, thread_stack_low, thread_stack_high);
+#endif
+    }
+
+    active_handler_count.fetch_sub(1, std::memory_order_seq_cst);
+    errno = saved_errno;
+}
+
+#endif
+
+void register_sampler_thread() {
+#ifdef SAMPLER_SUPPORTED
+    pthread_attr_t attributes;
+
+    if (pthread_getattr_np(pthread_self(), &attributes) != 0) {
+        return;
+    }
+
+    void* stack_address = nullptr;
+    size_t stack_size = 0;
+    pthread_attr_getstack(&attributes, &stack_address, &stack_size);
+    pthread_attr_destroy(&attributes);
+
+    thread_stack_low = reinterpret_cast<uintptr_t>(stack_address);
+    thread_stack_high = thread_stack_low + stack_size;
+#endif
+}
+
+SamplingProfiler::SamplingProfiler(const std::string& filename) : filename(filename) {
+#ifdef SAMPLER_SUPPORTED
+    assert(active_profiler.load() == nullptr && "only one sampling profiler can be active");
+    register_sampler_thread();
+    samples.reset(new StackSample[MAX_SAMPLE_COUNT]);
+
+    struct sigaction action {};
+    action.sa_sigaction = handle_sigprof;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, &previous_action);
+    active_profiler.store(this, std::memory_order_seq_cst);
+
+    itimerval timer {};
+    timer.it_interval.tv_usec = 1000000 / SAMPLE_FREQUENCY_HZ;
+    timer.it_value = timer.it_interval;
+
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        error = std::string("setitimer() failed: ") + std::strerror(errno);
+        active_profiler.store(nullptr, std::memory_order_seq_cst);
+        sigaction(SIGPROF, &previous_action, nullptr);
+    }
+#else
+    error = "sampling requires Linux on x86-64 or AArch64";
+#endif
+}
+
+SamplingProfiler::~SamplingProfiler() {
+    if (!is_available()) {
+        std::println("Sampling profiler unavailable: {}", error);
+        return;
+    }
+
+    itimerval timer {};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    active_profiler.store(nullptr, std::memory_order_seq_cst);
+
+    while (active_handler_count.load(std::memory_order_seq_cst) > 0) {}
+
+    sigaction(SIGPROF, &previous_action, nullptr);
+    write_folded_stacks();
+}
+
+// Walk the chain of frame records: every frame pointer points at the saved frame
+// pointer of the caller, followed by the return address into the caller. Frame
+// records must lie above the previous one and entirely within the stack of the
+// thread, or we would read arbitrary memory (e.g. when a library without frame
+// pointers used the frame pointer register for something else).
+
+void SamplingProfiler::record(
+    uintptr_t pc,
+    uintptr_t frame_pointer,
+    uintptr_t stack_pointer,
+    uintptr_t stack_low,
+    uintptr_t stack_high
+) {
+    size_t index = sample_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (index >= MAX_SAMPLE_COUNT) {
+        dropped_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    StackSample& sample = samples[index];
+    sample.addresses[0] = pc;
+    sample.depth = 1;
+    uintptr_t lower_bound = std::max(stack_pointer, stack_low);
+    const uintptr_t record_size = 2 * sizeof(uintptr_t);
+
+    while (sample.depth < MAX_SAMPLE_DEPTH && frame_pointer != 0) {
+        bool is_aligned = frame_pointer % sizeof(uintptr_t) == 0;
+        bool is_on_stack = frame_pointer >= lower_bound && stack_high >= record_size &&
+            frame_pointer <= stack_high - record_size;
+
+        if (!is_aligned || !is_on_stack) {
+            break;
+        }
+
+        const uintptr_t* frame = reinterpret_cast<const uintptr_t*>(frame_pointer);
+        uintptr_t return_address = frame[1];
+
+        if (return_address == 0) {
+            break;
+        }
+
+        sample.addresses[sample.depth++] = return_address;
+        lower_bound = frame_pointer + record_size;
+        frame_pointer = frame[0];
+    }
+}
+
+#ifdef SAMPLER_SUPPORTED
+
+// Function symbol of the executable, at its unrelocated address.
+
+struct FunctionSymbol {
+    uintptr_t address;
+    size_t size;
+    std::string name;
+};
+
+// Read the function symbols from the symbol table of the executable, or from its
+// dynamic symbol table if it was stripped, sorted by address.
+
+std::vector<FunctionSymbol> read_executable_symbols() {
+    std::ifstream file("/proc/self/exe", std::ios::binary);
+    std::string image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<FunctionSymbol> symbols;
+
+    if (image.size() < sizeof(Elf64_Ehdr) || std::memcmp(image.data(), ELFMAG, SELFMAG) != 0) {
+        return symbols;
+    }
+
+    const auto* header = reinterpret_cast<const Elf64_Ehdr*>(image.data());
+    const auto* sections = reinterpret_cast<const Elf64_Shdr*>(image.data() + header->e_shoff);
+
+    for (uint32_t symbol_type : { SHT_SYMTAB, SHT_DYNSYM }) {
+        for (size_t index = 0; index < header->e_shnum && symbols.empty(); ++index) {
+            const Elf64_Shdr& section = sections[index];
+
+            if (section.sh_type != symbol_type) {
+                continue;
+            }
+
+            const char* names = image.data() + sections[section.sh_link].sh_offset;
+            const auto* entries = reinterpret_cast<const Elf64_Sym*>(image.data() + section.sh_offset);
+
+            for (size_t entry = 0; entry < section.sh_size / sizeof(Elf64_Sym); ++entry) {
+                if (ELF64_ST_TYPE(entries[entry].st_info) == STT_FUNC && entries[entry].st_value != 0) {
+                    symbols.push_back(FunctionSymbol {
+                        entries[entry].st_value, entries[entry].st_size, names + entries[entry].st_name
+                    });
+                }
+            }
+        }
+    }
+
+    std::ranges::sort(symbols, {}, &FunctionSymbol::address);
+    return symbols;
+}
+
+// Load address of the executable (zero unless it is position-independent). The
+// executable is always the first object reported by `dl_iterate_phdr()`.
+
+uintptr_t get_executable_load_address() {
+    uintptr_t load_address = 0;
+
+    dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) {
+        *static_cast<uintptr_t*>(data) = info->dlpi_addr;
+        return 1;
+    }, &load_address);
+
+    return load_address;
+}
+
+std::string demangle(const char* name) {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+    if (status != 0 || demangled == nullptr) {
+        return name;
+    }
+
+    std::string result = demangled;
+    std::free(demangled);
+    return result;
+}
+
+// Resolves addresses to function names, with a cache per address, since the
+// same return addresses occur in many samples.
+
+struct Symbolizer {
+    std::vector<FunctionSymbol> symbols = read_executable_symbols();
+    uintptr_t load_address = get_executable_load_address();
+    std::unordered_map<uintptr_t, std::string> names;
+
+    const std::string& resolve(uintptr_t address) {
+        auto iter = names.find(address);
+
+        if (iter == names.end()) {
+            iter = names.emplace(address, lookup(address)).first;
+        }
+
+        return iter->second;
+    }
+
+    std::string lookup(uintptr_t address) {
+        uintptr_t offset = address - load_address;
+        auto symbol = std::ranges::upper_bound(symbols, offset, {}, &FunctionSymbol::address);
+
+        if (symbol != symbols.begin()) {
+            --symbol;
+
+            if (offset < symbol->address + std::max(symbol->size, (size_t) 1)) {
+                return demangle(symbol->name.c_str());
+            }
+        }
+
+        Dl_info info {};
+
+        if (dladdr(reinterpret_cast<void*>(address), &info) != 0) {
+            if (info.dli_sname != nullptr) {
+                return demangle(info.dli_sname);
+            } else if (info.dli_fname != nullptr) {
+                std::string library = info.dli_fname;
+                return "[" + library.substr(library.find_last_of('/') + 1) + "]";
+            }
+        }
+
+        return "[unknown]";
+    }
+};
+
+// Return addresses point just past the call instruction, which may already be
+// the first instruction of the next function, so we look up the byte before it.
+// Frames are joined from outermost to innermost.
+
+void SamplingProfiler::write_folded_stacks() {
+    Symbolizer symbolizer;
+    std::map<std::string, size_t> stack_counts;
+    std::map<std::string, size_t> self_counts;
+    size_t count = std::min(sample_count.load(), MAX_SAMPLE_COUNT);
+
+    for (size_t index = 0; index < count; ++index) {
+        const StackSample& sample = samples[index];
+        std::string stack;
+
+        for (size_t depth = sample.depth; depth > 0; --depth) {
+            uintptr_t address = sample.addresses[depth - 1] - (depth > 1 ? 1 : 0);
+            stack += symbolizer.resolve(address);
+            stack += (depth > 1) ? ";" : "";
+        }
+
+        stack_counts[stack] += 1;
+        self_counts[symbolizer.resolve(sample.addresses[0])] += 1;
+    }
+
+    std::ofstream output(filename);
+
+    for (const auto& [stack, stack_count] : stack_counts) {
+        output << stack << " " << stack_count << "\n";
+    }
+
+    std::println("Wrote {} samples ({} distinct stacks, {} dropped) to '{}'",
+        format_thousands((long) count), format_thousands((long) stack_counts.size()), dropped_count.load(), filename);
+
+    std::vector<std::pair<std::string, size_t>> hottest(self_counts.begin(), self_counts.end());
+    std::ranges::sort(hottest, std::greater<>(), &std::pair<std::string, size_t>::second);
+    hottest.resize(std::min(hottest.size(), SUMMARY_FUNCTION_COUNT));
+
+    for (const auto& [name, self_count] : hottest) {
+        std::println("  {:>5.1f}%  {}", 100.0 * (double) self_count / (double) count, name);
+    }
+}
+
+#else
+
+void SamplingProfiler::write_folded_stacks() {}
+
+#endif
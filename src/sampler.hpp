@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Built-in sampling profiler, for machines on which `perf` is not available. While
+// a `SamplingProfiler` exists, a profiling timer (`setitimer(ITIMER_PROF)`) sends
+// SIGPROF to the process at a fixed rate of CPU time, and the signal handler walks
+// the frame pointers of the interrupted thread, starting from the registers saved
+// in the signal context. Every sample is stored in a buffer that is allocated up
+// front, since the handler may not allocate; samples that do not fit are dropped.
+//
+// When the profiler is destroyed, the timer is stopped, and the return addresses
+// are symbolized using the symbol table of the binary itself ('/proc/self/exe',
+// which keeps its symbols since we build with -ggdb), falling back to `dladdr()`
+// for shared libraries. The stacks are then written as folded stacks, i.e. one
+// line per distinct stack, with frames from outermost to innermost separated by
+// semicolons, followed by the number of samples, which is the input format of
+// 'flamegraph.pl' and speedscope. Inlined functions are attributed to the
+// function they were inlined into.
+//
+// Frame pointers must be kept for the walk to work (SAMPLE=<file> compiles with
+// -fno-omit-frame-pointer); frames of libraries built without them may end the
+// walk early. The walk never leaves the stack of the interrupted thread, whose
+// bounds every thread records when it starts (see `register_sampler_thread()`);
+// for threads that did not, only the interrupted function is sampled. Only Linux
+// on x86-64 and AArch64 is supported; elsewhere, the profiler does nothing, and
+// `error` describes why.
+
+const size_t MAX_SAMPLE_DEPTH = 64;
+const size_t MAX_SAMPLE_COUNT = 1 << 15;
+
+// Sampling frequency in Hz of CPU time. Slightly off a round number, so that the
+// timer does not run in lockstep with periodic work in the solutions.
+const int SAMPLE_FREQUENCY_HZ = 997;
+
+struct StackSample {
+    size_t depth;
+    uintptr_t addresses[MAX_SAMPLE_DEPTH];
+};
+
+// Record the stack bounds of the calling thread, for the frame pointer walk of
+// samples taken on it. Called at the start of every thread that the harness
+// creates; the profiler registers the thread that creates it.
+
+void register_sampler_thread();
+
+struct SamplingProfiler {
+    std::string filename;
+    std::string error;
+    std::unique_ptr<StackSample[]> samples;
+    std::atomic<size_t> sample_count = 0;
+    std::atomic<size_t> dropped_count = 0;
+
+    explicit SamplingProfiler(const std::string& filename);
+    ~SamplingProfiler();
+
+    SamplingProfiler(const SamplingProfiler&) = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+    bool is_available() const {
+        return error.empty();
+    }
+
+    // Store a sample from the signal handler; only async-signal-safe operations.
+    // The stack of the interrupted thread spans [stack_low, stack_high), which
+    // is empty if the thread was not registered.
+    void record(uintptr_t pc, uintptr_t frame_pointer, uintptr_t stack_pointer, uintptr_t stack_low, uintptr_t stack_high);
+
+    // Write the folded stacks to the file, and print a summary of the hottest
+    // functions (by samples in which they are the innermost frame).
+    void write_folded_stacks();
+};
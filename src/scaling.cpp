@@ -0,0 +1,162 @@
+#include "scaling.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <format>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "profile.hpp"
+#include "solution.hpp"
+#include "thread_pool.hpp"
+
+std::vector<size_t> get_scaling_thread_counts(size_t max_thread_count) {
+    std::vector<size_t> thread_counts;
+
+    for (size_t thread_count = 1; thread_count < max_thread_count; thread_count *= 2) {
+        thread_counts.push_back(thread_count);
+    }
+
+    thread_counts.push_back(max_thread_count);
+    return thread_counts;
+}
+
+#if defined(__linux__)
+
+void pin_thread(pthread_t thread, int cpu) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    int result = pthread_setaffinity_np(thread, sizeof(cpus), &cpus);
+    assert(result == 0 && "failed to pin thread");
+}
+
+// Affinity of the calling thread when the sweep starts. New threads inherit the
+// affinity of the thread that creates them, so the calling thread is unpinned
+// (restored to this affinity) before every resize of the pool, and at the end.
+
+struct ThreadAffinity {
+    cpu_set_t original_cpus;
+    std::vector<int> allowed_cpus;
+
+    // Returns false if the affinity could not be read, in which case the threads
+    // must not be pinned, since there is nothing to restore.
+    bool save() {
+        if (pthread_getaffinity_np(pthread_self(), sizeof(original_cpus), &original_cpus) != 0) {
+            return false;
+        }
+
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &original_cpus)) {
+                allowed_cpus.push_back(cpu);
+            }
+        }
+
+        return !allowed_cpus.empty();
+    }
+
+    void restore() {
+        pthread_setaffinity_np(pthread_self(), sizeof(original_cpus), &original_cpus);
+    }
+
+    // Pin the calling thread to the first allowed CPU, and the workers of the pool
+    // to the following ones. If there are more threads than CPUs, we wrap around,
+    // which only happens if the maximum thread count was set above the CPU count.
+    void pin_pool_threads() {
+        ThreadPool& pool = get_thread_pool();
+        pin_thread(pthread_self(), allowed_cpus[0]);
+
+        for (size_t index = 0; index < pool.workers.size(); ++index) {
+            pin_thread(pool.workers[index].native_handle(), allowed_cpus[(index + 1) % allowed_cpus.size()]);
+        }
+    }
+};
+
+#endif
+
+std::vector<ScalingPoint> run_scaling(
+    const Solver& solve,
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    const ProfileOptions& options,
+    size_t max_thread_count,
+    [[maybe_unused]] bool pin_threads
+) {
+    ThreadPool& pool = get_thread_pool();
+    size_t original_thread_count = pool.thread_count();
+
+#if defined(__linux__)
+    ThreadAffinity affinity;
+
+    if (pin_threads && !affinity.save()) {
+        std::println("Could not read the CPU affinity of the calling thread, threads are not pinned");
+        pin_threads = false;
+    }
+#endif
+
+    std::vector<ScalingPoint> points;
+    std::string first_solution;
+
+    for (size_t thread_count : get_scaling_thread_counts(max_thread_count)) {
+#if defined(__linux__)
+        if (pin_threads) {
+            affinity.restore();
+        }
+#endif
+
+        pool.resize(thread_count);
+
+#if defined(__linux__)
+        if (pin_threads) {
+            affinity.pin_pool_threads();
+        }
+#endif
+
+        auto result = profile_solution(solve, lines, input_name, options);
+        std::string solution = stringify(result.solution);
+        assert((points.empty() || solution == first_solution) && "thread counts produced different solutions");
+        first_solution = solution;
+
+        double speedup = points.empty() ? 1.0 : points.front().statistics.median / result.statistics.median;
+        double inverse_count = 1.0 / (double) thread_count;
+        double serial_fraction = (thread_count > 1) ? (1.0 / speedup - inverse_count) / (1.0 - inverse_count) : 1.0;
+        points.push_back(ScalingPoint {
+            thread_count, result.statistics, speedup, speedup / (double) thread_count, serial_fraction
+        });
+        std::println("{:>3} threads: {:>12.2f} μs", thread_count, result.statistics.median);
+    }
+
+#if defined(__linux__)
+    if (pin_threads) {
+        affinity.restore();
+    }
+#endif
+
+    pool.resize(original_thread_count);
+    return points;
+}
+
+// The confidence interval is that of the mean (see 'statistics.hpp'), so it is
+// printed next to the mean; speedup is computed from the median, which is less
+// sensitive to outliers. The serial fraction is undefined for a single thread,
+// so it is left blank.
+
+void print_scaling_result(const std::vector<ScalingPoint>& points) {
+    std::println("");
+    std::println("{:>7} {:>14} {:>12} {:>12} {:>9} {:>11} {:>8}",
+        "Threads", "Median (μs)", "Mean (μs)", "95% CI ±", "Speedup", "Efficiency", "Serial");
+
+    for (const ScalingPoint& point : points) {
+        const Statistics& stats = point.statistics;
+        std::string serial = (point.thread_count > 1) ? std::format("{:.3f}", point.serial_fraction) : "-";
+        std::println("{:>7} {:>14.2f} {:>12.2f} {:>12.2f} {:>8.2f}x {:>10.1f}% {:>8}", point.thread_count, stats.median,
+            stats.mean, stats.ci_high - stats.mean, point.speedup, 100.0 * point.efficiency, serial);
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "profile.hpp"
+#include "solution.hpp"
+
+// Thread scaling: profile a solution repeatedly while resizing the shared thread
+// pool (see 'thread_pool.hpp') to 1, 2, 4, ... threads, up to the given maximum
+// (which is always included, even if it is not a power of two). For every thread
+// count p, with T(p) the median runtime, we report:
+// - Speedup: S(p) = T(1) / T(p).
+// - Efficiency: E(p) = S(p) / p, i.e. the fraction of the ideal linear speedup.
+// - Serial fraction: the Karp-Flatt metric e(p) = (1/S(p) - 1/p) / (1 - 1/p), the
+//   fraction of the work that behaves as if it were serial. If e(p) stays flat
+//   as p grows, scaling is limited by a fixed serial phase (Amdahl's law); if it
+//   grows with p, by overhead that grows with the thread count, e.g. contention
+//   for memory bandwidth, synchronization, or load imbalance.
+//
+// With pinning enabled, the calling thread and the worker threads are pinned to
+// distinct CPUs, taken in order from the CPUs that the process may run on, so
+// that the scheduler does not migrate threads between measurements. Linux usually
+// numbers all physical cores before their SMT siblings, so small thread counts
+// then run on separate cores. The original affinity of the calling thread and
+// the original pool size are restored afterwards. Pinning uses the affinity API
+// of Linux, and is not supported on other platforms.
+
+#if defined(__linux__)
+const bool THREAD_PINNING_SUPPORTED = true;
+#else
+const bool THREAD_PINNING_SUPPORTED = false;
+#endif
+
+// Results for a single thread count.
+
+struct ScalingPoint {
+    size_t thread_count;
+    Statistics statistics;
+    double speedup;
+    double efficiency;
+    double serial_fraction;
+};
+
+// Thread counts of a sweep: powers of two below `max_thread_count`, followed by
+// `max_thread_count` itself.
+
+std::vector<size_t> get_scaling_thread_counts(size_t max_thread_count);
+
+std::vector<ScalingPoint> run_scaling(
+    const Solver& solve,
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    const ProfileOptions& options,
+    size_t max_thread_count,
+    bool pin_threads
+);
+
+void print_scaling_result(const std::vector<ScalingPoint>& points);
@@ -0,0 +1,481 @@
+#include "server.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <print>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "input.hpp"
+#include "sampler.hpp"
+#include "solution.hpp"
+#include "solve_context.hpp"
+#include "statistics.hpp"
+
+// Throughput in the server statistics is reported both since startup, and over
+// this many seconds before the statistics were requested, which reflects the
+// current load when clients come and go.
+const double RECENT_WINDOW_S = 10.0;
+
+// Reads newline-terminated lines from a socket. Carriage returns before the
+// newline are dropped, so that requests can also be typed in e.g. telnet.
+
+struct LineReader {
+    int fd;
+    std::string buffer;
+
+    bool read_line(std::string& line) {
+        size_t newline = buffer.find('\n');
+
+        while (newline == std::string::npos) {
+            char chunk[4096];
+            ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+
+            if (count <= 0) {
+                return false;
+            }
+
+            buffer.append(chunk, count);
+            newline = buffer.find('\n');
+        }
+
+        line.assign(buffer, 0, (newline > 0 && buffer[newline - 1] == '\r') ? newline - 1 : newline);
+        buffer.erase(0, newline + 1);
+        return true;
+    }
+};
+
+// Peers that have gone away must not kill the server (or the query clients) with
+// a SIGPIPE. Linux has a flag for this on every send(), while macOS only has the
+// socket option SO_NOSIGPIPE, which must be set once on every connected socket.
+
+#if defined(MSG_NOSIGNAL)
+const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+const int SEND_FLAGS = 0;
+#endif
+
+void disable_sigpipe([[maybe_unused]] int fd) {
+#if defined(SO_NOSIGPIPE)
+    int enabled = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+}
+
+// Write a full line to a socket.
+
+bool write_line(int fd, const std::string& line) {
+    std::string data = line + "\n";
+    size_t offset = 0;
+
+    while (offset < data.size()) {
+        ssize_t count = send(fd, data.data() + offset, data.size() - offset, SEND_FLAGS);
+
+        if (count <= 0) {
+            return false;
+        }
+
+        offset += count;
+    }
+
+    return true;
+}
+
+sockaddr_un get_socket_address(const std::string& socket_path) {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    assert(socket_path.size() < sizeof(address.sun_path) && "socket path too long");
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+
+// An input file that is kept mapped by the server, together with the time at which
+// it was last modified, so that it can be reloaded when it changes. Inputs are
+// shared, since a request may still be solving on the old mapping while another
+// request triggers a reload.
+
+struct LoadedInput {
+    std::shared_ptr<const InputFile> file;
+    std::filesystem::file_time_type write_time;
+};
+
+// A solve context that is not in use, and the input generation it has last seen.
+
+struct IdleContext {
+    std::unique_ptr<SolveContext> context;
+    size_t generation;
+};
+
+struct Server {
+    const std::map<std::string, Solver>& solutions;
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    int listen_fd = -1;
+
+    // Everything below is guarded by the mutex. Samples are stored as pairs of the
+    // completion time (in seconds since startup) and the solve time.
+    std::mutex mutex;
+    std::condition_variable clients_changed;
+    std::map<std::string, LoadedInput> inputs;
+    size_t input_generation = 0;
+    std::vector<IdleContext> idle_contexts;
+    std::vector<std::pair<double, double>> solve_samples;
+    size_t request_count = 0;
+    size_t error_count = 0;
+    size_t client_count = 0;
+    size_t peak_client_count = 0;
+    bool is_stopping = false;
+
+    explicit Server(const std::map<std::string, Solver>& solutions) : solutions(solutions) {}
+
+    double get_uptime_s() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    // Get the mapped input file, loading it if it has not been loaded yet, or if
+    // it changed since it was loaded, together with the current input generation.
+    // Returns a null pointer if the file does not exist. Loading happens under the
+    // lock, which only delays other requests the first time an input is used.
+    std::shared_ptr<const InputFile> get_input(const std::string& filename, size_t& generation) {
+        std::error_code error;
+        auto write_time = std::filesystem::last_write_time(filename, error);
+
+        if (error) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto iter = inputs.find(filename);
+
+        if (iter != inputs.end() && iter->second.write_time == write_time) {
+            generation = input_generation;
+            return iter->second.file;
+        }
+
+        if (iter != inputs.end()) {
+            input_generation++;
+        }
+
+        generation = input_generation;
+
+        LoadedInput& input = inputs[filename];
+        input.file = std::make_shared<const InputFile>(filename);
+        input.write_time = write_time;
+        return input.file;
+    }
+
+    // Take an idle solve context, or create one if all of them are in use. Pooling
+    // contexts (rather than giving each connection its own) keeps their arenas and
+    // cached arrays warm for clients that connect once per request. A context that
+    // was last used in another input generation may have hashed an input buffer
+    // that has been unmapped since, so it has to forget that hash.
+    std::unique_ptr<SolveContext> acquire_context(size_t generation) {
+        std::unique_ptr<SolveContext> context;
+        bool is_outdated = false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (idle_contexts.empty()) {
+                return std::make_unique<SolveContext>();
+            }
+
+            context = std::move(idle_contexts.back().context);
+            is_outdated = idle_contexts.back().generation != generation;
+            idle_contexts.pop_back();
+        }
+
+        if (is_outdated) {
+            context->cache.forget_content_hash();
+        }
+
+        return context;
+    }
+
+    void release_context(std::unique_ptr<SolveContext> context, size_t generation) {
+        std::lock_guard<std::mutex> lock(mutex);
+        idle_contexts.push_back(IdleContext { std::move(context), generation });
+    }
+
+    std::string solve(const std::string& day_part, const std::string& input_name) {
+        auto iter = solutions.find(day_part);
+
+        if (iter == solutions.end()) {
+            return std::format("error unknown solution '{}'", day_part);
+        }
+
+        auto filename = get_input_filename(day_part, input_name);
+        size_t generation = 0;
+        std::shared_ptr<const InputFile> input_file = get_input(filename, generation);
+
+        if (input_file == nullptr) {
+            return std::format("error no input file '{}'", filename);
+        }
+
+        std::unique_ptr<SolveContext> context = acquire_context(generation);
+        context->reset();
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        auto solution = iter->second(input_file->lines, input_name, *context);
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        double duration_us = std::chrono::duration<double, std::micro>(end_time - start_time).count();
+        release_context(std::move(context), generation);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            solve_samples.emplace_back(get_uptime_s(), duration_us);
+        }
+
+        return std::format("ok {} {:.2f}", stringify(solution), duration_us);
+    }
+
+    // Format the server statistics as 'key=value' pairs. The throughput since
+    // startup includes idle time, so under a benchmark load the recent value is
+    // the one to look at.
+    std::string format_stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        double uptime_s = get_uptime_s();
+        double window_s = std::min(uptime_s, RECENT_WINDOW_S);
+        std::vector<double> sorted_us;
+        size_t recent_count = 0;
+
+        for (const auto& [time_s, duration_us] : solve_samples) {
+            sorted_us.push_back(duration_us);
+            recent_count += (time_s >= uptime_s - window_s) ? 1 : 0;
+        }
+
+        std::ranges::sort(sorted_us);
+
+        return std::format(
+            "requests={} solved={} errors={} uptime_s={:.1f} throughput_rps={:.1f} recent_rps={:.1f} "
+            "clients={} peak_clients={} inputs={} contexts={} solve_p50_us={:.2f} solve_p90_us={:.2f} solve_p99_us={:.2f}",
+            request_count, solve_samples.size(), error_count, uptime_s,
+            (double) solve_samples.size() / uptime_s, (double) recent_count / window_s,
+            client_count, peak_client_count, inputs.size(), idle_contexts.size(),
+            percentile(sorted_us, 0.5), percentile(sorted_us, 0.9), percentile(sorted_us, 0.99)
+        );
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            is_stopping = true;
+        }
+
+        // Wake up the accept() call of the main thread.
+        shutdown(listen_fd, SHUT_RDWR);
+    }
+
+    std::string handle_request(const std::string& request) {
+        std::vector<std::string> words;
+
+        for (auto word : std::views::split(request, ' ')) {
+            if (!word.empty()) {
+                words.emplace_back(std::string_view(word));
+            }
+        }
+
+        std::string response;
+
+        if (words.size() == 3 && words[0] == "solve") {
+            response = solve(words[1], words[2]);
+        } else if (words.size() == 1 && words[0] == "stats") {
+            response = "ok " + format_stats();
+        } else if (words.size() == 1 && words[0] == "shutdown") {
+            stop();
+            response = "ok";
+        } else {
+            response = std::format("error unknown request '{}'", request);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        request_count++;
+        error_count += response.starts_with("error") ? 1 : 0;
+        return response;
+    }
+
+    void handle_connection(int fd) {
+        register_sampler_thread();
+        LineReader reader { fd, "" };
+        std::string request;
+
+        while (reader.read_line(request)) {
+            if (!request.empty() && !write_line(fd, handle_request(request))) {
+                break;
+            }
+        }
+
+        close(fd);
+        std::lock_guard<std::mutex> lock(mutex);
+        client_count--;
+        clients_changed.notify_all();
+    }
+
+    // Solve every solution once on the given input, to load the input files, build
+    // the cache files, and grow the arena of the first context.
+    void warm_up(const std::string& input_name) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        size_t warm_count = 0;
+
+        for (const auto& [day_part, solver] : solutions) {
+            if (std::filesystem::exists(get_input_filename(day_part, input_name))) {
+                solve(day_part, input_name);
+                warm_count++;
+            }
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        double duration_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+        std::println("Warmed up {} solutions on '{}' in {:.3f} ms", warm_count, input_name, duration_ms);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        solve_samples.clear();
+    }
+
+    // Accept connections until a client requests a shutdown, handling every one
+    // on its own (detached) thread, and then wait for all clients to disconnect.
+    void run(const std::string& socket_path) {
+        listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        assert(listen_fd != -1);
+
+        // A socket file left behind by a server that was killed would make bind() fail.
+        unlink(socket_path.c_str());
+        sockaddr_un address = get_socket_address(socket_path);
+        int result = bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        assert(result == 0 && "could not bind the server socket");
+        result = listen(listen_fd, SOMAXCONN);
+        assert(result == 0);
+
+        std::println("Listening on '{}' ({} solutions)", socket_path, solutions.size());
+        std::fflush(stdout);
+
+        while (true) {
+            int client_fd = accept(listen_fd, nullptr, nullptr);
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (is_stopping) {
+                if (client_fd != -1) {
+                    close(client_fd);
+                }
+
+                break;
+            } else if (client_fd == -1) {
+                assert(errno == EINTR || errno == ECONNABORTED);
+                continue;
+            }
+
+            disable_sigpipe(client_fd);
+            client_count++;
+            peak_client_count = std::max(peak_client_count, client_count);
+            std::thread([this, client_fd]() { handle_connection(client_fd); }).detach();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            clients_changed.wait(lock, [this]() { return client_count == 0; });
+        }
+
+        close(listen_fd);
+        unlink(socket_path.c_str());
+    }
+};
+
+void serve(const std::map<std::string, Solver>& solutions, const std::string& input_name, const std::string& socket_path) {
+    Server server(solutions);
+    server.warm_up(input_name);
+    server.run(socket_path);
+    std::println("Server stopped: {}", server.format_stats());
+}
+
+int connect_to_server(const std::string& socket_path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    assert(fd != -1);
+    sockaddr_un address = get_socket_address(socket_path);
+    int result = connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    assert(result == 0 && "could not connect to the server; is it running?");
+    disable_sigpipe(fd);
+    return fd;
+}
+
+std::string send_request(const std::string& socket_path, const std::string& request) {
+    int fd = connect_to_server(socket_path);
+    LineReader reader { fd, "" };
+    std::string response;
+    write_line(fd, request);
+    reader.read_line(response);
+    close(fd);
+    return response;
+}
+
+QueryResult query_server(
+    const std::string& socket_path,
+    const std::vector<std::string>& requests,
+    size_t client_count,
+    size_t request_count
+) {
+    assert(!requests.empty() && client_count > 0);
+    std::vector<std::vector<double>> client_latencies(client_count);
+    std::vector<size_t> client_errors(client_count, 0);
+    std::vector<std::thread> clients;
+    auto start_time = std::chrono::steady_clock::now();
+
+    for (size_t client = 0; client < client_count; ++client) {
+        clients.emplace_back([&, client]() {
+            register_sampler_thread();
+            int fd = connect_to_server(socket_path);
+            LineReader reader { fd, "" };
+            std::string response;
+            size_t begin = (request_count * client) / client_count;
+            size_t end = (request_count * (client + 1)) / client_count;
+
+            for (size_t index = begin; index < end; ++index) {
+                auto request_time = std::chrono::steady_clock::now();
+                bool is_answered = write_line(fd, requests[index % requests.size()]) &&
+                    reader.read_line(response);
+                auto response_time = std::chrono::steady_clock::now();
+
+                if (!is_answered || response.starts_with("error")) {
+                    client_errors[client]++;
+                }
+
+                client_latencies[client].push_back(
+                    std::chrono::duration<double, std::micro>(response_time - request_time).count());
+            }
+
+            close(fd);
+        });
+    }
+
+    for (std::thread& client : clients) {
+        client.join();
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    QueryResult result { {}, std::chrono::duration<double, std::micro>(end_time - start_time).count(), 0 };
+
+    for (size_t client = 0; client < client_count; ++client) {
+        result.latencies_us.insert(result.latencies_us.end(), client_latencies[client].begin(), client_latencies[client].end());
+        result.error_count += client_errors[client];
+    }
+
+    return result;
+}
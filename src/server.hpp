@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "solution.hpp"
+
+// Default path of the Unix domain socket on which the server listens, relative to
+// the working directory (i.e. the root of the repository when started by make).
+const std::string DEFAULT_SOCKET_PATH = "server.sock";
+
+// Resident solver server. Instead of paying for process startup, loading the input,
+// and cold caches on every run, the server keeps its input files mapped, and keeps
+// a pool of solve contexts whose arenas and binary input caches stay warm between
+// requests. Clients connect to a Unix domain socket and send one request per line;
+// every request gets exactly one response line:
+// - 'solve <day_part> <input_name>' solves the given task, and responds with 'ok
+//   <solution> <microseconds>', where the time is the solve time only, since the
+//   input is usually loaded already (it is loaded on first use otherwise, and
+//   reloaded when the file changes);
+// - 'stats' responds with 'ok' followed by 'key=value' pairs: the request counts,
+//   the uptime, the throughput in requests per second since startup, the current
+//   and peak number of connected clients, and percentiles of the solve time;
+// - 'shutdown' responds with 'ok', and stops the server once all connected clients
+//   have disconnected.
+// Failed requests get a response of the form 'error <message>'. Every connection
+// is handled by its own thread, so concurrent clients are solved concurrently.
+// Parallel solutions share the thread pool (see 'thread_pool.hpp') as usual.
+//
+// Before accepting connections, the server solves every selected solution once on
+// the given input (if it exists), so that the first requests for it are warm too.
+
+void serve(const std::map<std::string, Solver>& solutions, const std::string& input_name, const std::string& socket_path);
+
+// Results of sending requests to a running server from concurrent clients, as
+// measured by the clients: the round-trip latency of every request (in micro-
+// seconds), the total wall time, and the number of failed requests.
+
+struct QueryResult {
+    std::vector<double> latencies_us;
+    double duration_us;
+    size_t error_count;
+};
+
+// Open `client_count` connections to the server, and send `request_count` requests
+// in total, spread evenly over the connections. Every client cycles through the
+// given requests, and waits for the response to a request before sending the next.
+
+QueryResult query_server(
+    const std::string& socket_path,
+    const std::vector<std::string>& requests,
+    size_t client_count,
+    size_t request_count
+);
+
+// Send a single request to the server on a new connection, and return its response.
+
+std::string send_request(const std::string& socket_path, const std::string& request);
@@ -1,11 +1,109 @@
 #pragma once
 
+#include <functional>
+#include <map>
+#include <span>
 #include <string>
+#include <string_view>
 #include <variant>
+#include <vector>
+
+#include "solve_context.hpp"
 
 typedef std::variant<int, long, double, std::string> Solution;
 
-inline std::string stringify(Solution& solution) {
+// Signature of the solve() function, to be implemented by the individual solution files.
+// The 'lines' argument contains views into the memory-mapped input file (see 'input.hpp').
+// The 'input_name' argument contains the base name of the input file (e.g. 'sample' or
+// 'input'), which can for example be used if the sample input and the real input use
+// different logic and/or constraints.
+
+typedef Solution (*SolveFunction)(const std::vector<std::string_view>& lines, const std::string& input_name);
+
+// Alternative signature for solutions that opt in to the solve context (see 'solve_context.hpp'),
+// for example to allocate their containers from the context's arena.
+
+typedef Solution (*ContextSolveFunction)(
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    SolveContext& context
+);
+
+// Uniform wrapper around both signatures, as used by the harness. Solutions that do not
+// take a context simply ignore it.
+
+typedef std::function<Solution(const std::vector<std::string_view>&, const std::string&, SolveContext&)> Solver;
+
+// Registry of all solutions linked into the binary, keyed by day and part (e.g. "01a").
+// Every solution file defines its solve() function in its own namespace (e.g. 'day01::
+// part_a'), and registers it using `REGISTER_SOLUTION()` during static initialization.
+// The registry is a function-local static, so that it is guaranteed to be constructed
+// before the first registration, regardless of the order in which files are linked.
+
+inline std::map<std::string, Solver>& get_solutions() {
+    static std::map<std::string, Solver> solutions;
+    return solutions;
+}
+
+struct SolutionRegistrar {
+    SolutionRegistrar(const std::string& day_part, SolveFunction solve) {
+        get_solutions()[day_part] = [solve](const auto& lines, const auto& input_name, SolveContext&) {
+            return solve(lines, input_name);
+        };
+    }
+
+    SolutionRegistrar(const std::string& day_part, ContextSolveFunction solve) {
+        get_solutions()[day_part] = solve;
+    }
+};
+
+#define REGISTER_SOLUTION(day_part, solve) \
+    static const SolutionRegistrar solution_registrar { day_part, solve }
+
+// Streaming solutions look at every line once, in order, and never return to it, so
+// they do not need the whole input in memory. Such a solution is a struct that is
+// default-constructible, and implements `void consume(std::span<const std::string_view>
+// lines)`, which is called with consecutive blocks of lines, followed by `Solution
+// finish()` once all lines have been consumed. The views passed to `consume()` are
+// only valid during the call.
+//
+// `REGISTER_STREAMING_SOLUTION()` registers the solution twice: in the regular registry
+// (consuming all lines of the mapped input in a single block), so that it works with
+// every mode of the harness, and in the streaming registry, which takes a line feed
+// that calls its argument once per block (see 'stream.hpp').
+
+typedef std::function<void(std::span<const std::string_view>)> LineConsumer;
+
+typedef std::function<void(const LineConsumer&)> LineFeed;
+
+typedef std::function<Solution(const LineFeed&)> StreamingSolver;
+
+inline std::map<std::string, StreamingSolver>& get_streaming_solutions() {
+    static std::map<std::string, StreamingSolver> solutions;
+    return solutions;
+}
+
+template <typename State>
+struct StreamingSolutionRegistrar {
+    explicit StreamingSolutionRegistrar(const std::string& day_part) {
+        get_solutions()[day_part] = [](const auto& lines, const auto&, SolveContext&) {
+            State state {};
+            state.consume(std::span(lines));
+            return state.finish();
+        };
+
+        get_streaming_solutions()[day_part] = [](const LineFeed& feed) {
+            State state {};
+            feed([&state](std::span<const std::string_view> lines) { state.consume(lines); });
+            return state.finish();
+        };
+    }
+};
+
+#define REGISTER_STREAMING_SOLUTION(day_part, State) \
+    static const StreamingSolutionRegistrar<State> solution_registrar { day_part }
+
+inline std::string stringify(const Solution& solution) {
     if (int const* val = std::get_if<int>(&solution))
       return std::to_string(*val);
 
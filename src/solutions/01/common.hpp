@@ -1,5 +1,19 @@
 #pragma once
 
-#include <string>
+#include <string_view>
 
-int parse_line(const std::string& line);
+#include "../../parsing.hpp"
+
+namespace day01 {
+
+// Parse a line to an integer. The return value is equal to the parsed number
+// if the line starts with 'R', or minus that number if line start with 'L'.
+// The function is constexpr, so that it can also be used to solve the input at
+// compile time (see 'embedded.hpp'), which the shared digit parser supports.
+
+constexpr int parse_line(const std::string_view& line) {
+    auto direction = line.front() == 'R' ? 1 : -1;
+    return direction * (int) parse_digits(line.substr(1));
+}
+
+} // namespace day01
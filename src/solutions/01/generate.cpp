@@ -0,0 +1,23 @@
+#include <cstddef>
+#include <ostream>
+
+#include "../../generator.hpp"
+
+namespace day01 {
+
+// The real input contains about 4,500 rotations, each consisting of a direction
+// ('L' or 'R') and a number of clicks between 1 and 999.
+
+const size_t BASE_ROTATION_COUNT = 4500;
+
+bool generate(std::ostream& output, size_t scale, Random& random) {
+    for (size_t index = 0; index < BASE_ROTATION_COUNT * scale; ++index) {
+        output << (random.chance(0.5) ? 'L' : 'R') << random.between(1, 999) << '\n';
+    }
+
+    return true;
+}
+
+} // namespace day01
+
+REGISTER_GENERATOR("01", day01::generate);
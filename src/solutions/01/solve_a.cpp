@@ -1,11 +1,14 @@
 #include <algorithm>
 #include <ranges>
-#include <string>
-#include <vector>
+#include <span>
+#include <string_view>
 
+#include "../../embedded.hpp"
 #include "../../solution.hpp"
 #include "common.hpp"
 
+namespace day01::part_a {
+
 /*
     We first parse the input, converting lines starting with 'R' to positive
     integers and lines starting with 'L' to negative ones. We then iterate over
@@ -22,19 +25,35 @@
     like the pipe notation used to lazily parse the input lines.
 */
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
+// Streaming state: the current dial position and the number of zeros so far.
+// Lines are consumed in blocks as they are read, so memory use is constant.
+
+struct Dial {
     int current = 50;
     int zeros = 0;
 
-    auto count_zeros = [&](int value) {
-        current = (current + value) % 100;
+    constexpr void consume(std::span<const std::string_view> lines) {
+        auto count_zeros = [&](int value) {
+            current = (current + value) % 100;
+
+            if (current == 0) {
+                zeros += 1;
+            }
+        };
+
+        std::ranges::for_each(lines | std::views::transform(parse_line), count_zeros);
+    }
+
+    constexpr Solution finish() const {
+        return Solution { zeros };
+    }
+};
+
+} // namespace day01::part_a
 
-        if (current == 0) {
-            zeros += 1;
-        }
-    };
-    
-    std::ranges::for_each(lines | std::views::transform(parse_line), count_zeros);
+REGISTER_STREAMING_SOLUTION("01a", day01::part_a::Dial);
 
-    return Solution { zeros };
-}
+#if defined(EMBED_INPUTS) && __has_include("input_01.hpp")
+#include "input_01.hpp"
+REGISTER_EMBEDDED_SOLUTION("01a", solve_embedded<day01::part_a::Dial>(day01::EMBEDDED_INPUT));
+#endif
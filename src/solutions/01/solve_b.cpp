@@ -1,11 +1,14 @@
 #include <algorithm>
 #include <ranges>
-#include <string>
-#include <vector>
+#include <span>
+#include <string_view>
 
+#include "../../embedded.hpp"
 #include "../../solution.hpp"
 #include "common.hpp"
 
+namespace day01::part_b {
+
 /*
     We could calculate every position of the dail and check if it's zero, but
     this is clearly not efficient. Instead, we calculate the number of zeros
@@ -40,7 +43,7 @@
 // simply the position divided by 100. For negative positions, we adjust it so
 // that -1 to -100 are cycle -1, -101 to -200 are cycle -2, and so on.
 
-int get_cycle(int position) {
+constexpr int get_cycle(int position) {
     return position >= 0 ? (position / 100) : ((position + 1) / 100) - 1;
 }
 
@@ -48,7 +51,7 @@ int get_cycle(int position) {
 // turning the dail to the right. For positive moves, this is equal to the differ-
 // ence between the cycle counts of the start and end positions.
 
-int count_zeros_pos(int start, int end) {
+constexpr int count_zeros_pos(int start, int end) {
     int start_cycle = get_cycle(start);
     int end_cycle = get_cycle(end);
     return end_cycle - start_cycle;
@@ -58,27 +61,43 @@ int count_zeros_pos(int start, int end) {
 // turning the dail to the left. For negative moves, we have to subtract one from
 // the start and end positions in order to avoid the edge cases mentioned above.
 
-int count_zeros_neg(int start, int end) {
+constexpr int count_zeros_neg(int start, int end) {
     int start_cycle = get_cycle(start - 1);
     int end_cycle = get_cycle(end - 1);
     return start_cycle - end_cycle;
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
+// Streaming state: the current (continuous) dial position and the number of
+// zeros passed so far. Lines are consumed in blocks as they are read.
+
+struct Dial {
     int current = 50;
     int zeros = 0;
 
-    auto count_zeros = [&](int value) {
-        int next = current + value;
+    constexpr void consume(std::span<const std::string_view> lines) {
+        auto count_zeros = [&](int value) {
+            int next = current + value;
 
-        zeros += (value >= 0) ? 
-            count_zeros_pos(current, next) :
-            count_zeros_neg(current, next);
-        
-        current = next;
-    };
+            zeros += (value >= 0) ? 
+                count_zeros_pos(current, next) :
+                count_zeros_neg(current, next);
+            
+            current = next;
+        };
 
-    std::ranges::for_each(lines | std::views::transform(parse_line), count_zeros);
+        std::ranges::for_each(lines | std::views::transform(parse_line), count_zeros);
+    }
 
-    return Solution { zeros };
-}
+    constexpr Solution finish() const {
+        return Solution { zeros };
+    }
+};
+
+} // namespace day01::part_b
+
+REGISTER_STREAMING_SOLUTION("01b", day01::part_b::Dial);
+
+#if defined(EMBED_INPUTS) && __has_include("input_01.hpp")
+#include "input_01.hpp"
+REGISTER_EMBEDDED_SOLUTION("01b", solve_embedded<day01::part_b::Dial>(day01::EMBEDDED_INPUT));
+#endif
@@ -1,5 +1,13 @@
 #pragma once
 
-#include <string_view>
+#include <cstddef>
 
-long string_view_to_long(const std::string_view& string_view);
+namespace day02 {
+
+// Minimum number of ranges per chunk when solving ranges in parallel. A range
+// takes about 0.1 μs in part A and 0.3 to 0.5 μs in part B, so chunks do tens of
+// microseconds of work, well above the cost of handing a task to a worker. The
+// real input (about 35 ranges) is therefore solved on the calling thread.
+const size_t RANGES_PER_CHUNK = 256;
+
+} // namespace day02
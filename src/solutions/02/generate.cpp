@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../generator.hpp"
+
+namespace day02 {
+
+// The real input is a single line with about 35 comma-separated ranges, with
+// limits of two to ten digits. The solutions assume that ranges do not overlap,
+// so we first pick sorted start values, and then cut off every range before
+// the start of the next one. Range widths vary from a few IDs to 100,000 IDs.
+// Limits stay below 10^10, so that sums of invalid IDs easily fit in a long.
+
+const size_t BASE_RANGE_COUNT = 35;
+
+long power_of_ten(long exponent) {
+    long result = 1;
+
+    for (long i = 0; i < exponent; ++i) {
+        result *= 10;
+    }
+
+    return result;
+}
+
+bool generate(std::ostream& output, size_t scale, Random& random) {
+    std::vector<long> starts;
+
+    for (size_t index = 0; index < BASE_RANGE_COUNT * scale; ++index) {
+        long digits = random.between(2, 10);
+        starts.push_back(random.between(power_of_ten(digits - 1), power_of_ten(digits) - 1));
+    }
+
+    std::ranges::sort(starts);
+    auto duplicates = std::ranges::unique(starts);
+    starts.erase(duplicates.begin(), duplicates.end());
+
+    std::vector<std::pair<long, long>> ranges;
+
+    for (size_t index = 0; index < starts.size(); ++index) {
+        long width = random.between(0, power_of_ten(random.between(1, 5)));
+        long end = starts[index] + width;
+
+        if (index + 1 < starts.size()) {
+            end = std::min(end, starts[index + 1] - 1);
+        }
+
+        ranges.emplace_back(starts[index], end);
+    }
+
+    random.shuffle(ranges);
+
+    for (size_t index = 0; index < ranges.size(); ++index) {
+        output << (index > 0 ? "," : "") << ranges[index].first << '-' << ranges[index].second;
+    }
+
+    output << '\n';
+    return true;
+}
+
+} // namespace day02
+
+REGISTER_GENERATOR("02", day02::generate);
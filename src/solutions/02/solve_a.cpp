@@ -1,14 +1,22 @@
 // clang incorrectly reports algorithm as unused
 #include <algorithm> // IWYU pragma: keep
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "../../parsing.hpp"
 #include "../../solution.hpp"
+#include "../../thread_pool.hpp"
+#include "../../trace.hpp"
 #include "common.hpp"
 
+namespace day02::part_a {
+
 /*
     We parse the minimum and maximum values of each range, and additionally
     parse the value of their left half (LH), i.e. the numeric value of the
@@ -70,8 +78,8 @@ struct LimitInfo {
     static LimitInfo parse(const std::string_view& sv) {
         size_t lh_digits = sv.length() / 2;
         long multiplier = std::pow(10, sv.length() - lh_digits);
-        long lh_value = string_view_to_long(sv.substr(0, lh_digits));
-        long value = string_view_to_long(sv);
+        long lh_value = parse_long(sv.substr(0, lh_digits));
+        long value = parse_long(sv);
 
         return LimitInfo { 
             value,
@@ -142,30 +150,36 @@ long solve_range(const std::string_view& min_sv, const std::string_view& max_sv)
     return invalid_id_sum;
 }
 
-// Parse and solve a single range string, e.g. "123-234". First find the
-// position of the dash, and then create one string view per limit value.
-
-long solve_group(const std::ranges::subrange<const char *>&& group) {
-    std::string_view group_sv = std::string_view(group);
-    size_t dash_pos = group_sv.find('-');
-
-    auto min_sv = group_sv.substr(0, dash_pos);
-    auto max_sv = group_sv.substr(dash_pos + 1);
+// Parse and solve a single range string, e.g. "123-234", by splitting it at
+// the dash into one string view per limit value.
 
+long solve_group(const std::string_view& group_sv) {
+    auto [min_sv, max_sv] = split_fields<2>(group_sv, '-');
     return solve_range(min_sv, max_sv);
 }
 
-// Split the ranges by commas, compute the sum of invalid IDs in each
-// range, and compute the sum of sums as the final answer.
+// Split the ranges by commas, compute the sum of invalid IDs in each range,
+// and compute the sum of sums as the final answer. Ranges are independent,
+// so we solve chunks of ranges in parallel on the shared thread pool.
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    const std::string& first_line = lines.front();
+Solution solve(const std::vector<std::string_view>& lines, [[maybe_unused]] const std::string& input_name) {
+    const std::string_view& first_line = lines.front();
 
-    auto results = std::string_view(first_line)
-        | std::views::split(',')
-        | std::views::transform(solve_group);
+    auto groups = [&]() {
+        TRACE_SCOPE("parse");
+        return std::ranges::to<std::vector>(first_line
+            | std::views::split(',')
+            | std::views::transform([](auto&& group) { return std::string_view(group); }));
+    }();
 
-    long total = std::ranges::fold_left(results, 0, std::plus{});
+    long total = parallel_reduce(0, groups.size(), RANGES_PER_CHUNK, 0L, [&](size_t begin, size_t end) {
+        auto chunk = std::span(groups).subspan(begin, end - begin);
+        return std::ranges::fold_left(chunk | std::views::transform(solve_group), 0L, std::plus{});
+    }, std::plus{});
 
     return Solution { total };
 }
+
+} // namespace day02::part_a
+
+REGISTER_SOLUTION("02a", day02::part_a::solve);
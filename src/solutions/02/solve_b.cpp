@@ -2,15 +2,22 @@
 #include <algorithm> // IWYU pragma: keep
 #include <cmath>
 #include <cstddef>
+#include <functional>
 #include <ranges>
 #include <set>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "../../parsing.hpp"
 #include "../../solution.hpp"
+#include "../../thread_pool.hpp"
+#include "../../trace.hpp"
 #include "common.hpp"
 
+namespace day02::part_b {
+
 /*
     If the minimum and maximum of a range have the same length, we now iterate
     over all prefix lengths that are a divisor of the min/max length (i.e. the
@@ -44,7 +51,7 @@ struct Limit {
     long value;
 
     static Limit parse(const std::string_view& sv) {
-        return Limit { sv, string_view_to_long(sv) };
+        return Limit { sv, parse_long(sv) };
     }
 };
 
@@ -93,8 +100,8 @@ void solve_for_prefix_length(
 ) {
     std::string_view min_prefix_sv = range.min.sv.substr(0, prefix_length);
     std::string_view max_prefix_sv = range.max.sv.substr(0, prefix_length);
-    long min_prefix_value = string_view_to_long(min_prefix_sv);
-    long max_prefix_value = string_view_to_long(max_prefix_sv);
+    long min_prefix_value = parse_long(min_prefix_sv);
+    long max_prefix_value = parse_long(max_prefix_sv);
 
     for (long v = min_prefix_value; v <= max_prefix_value; ++v) {
         long invalid_id = compute_invalid_id(v, prefix_length, repeat_count);
@@ -154,31 +161,38 @@ long solve_range(Range range) {
     return std::ranges::fold_left(invalid_ids, 0, std::plus {});
 }
 
-// Parse and solve a single range string, e.g. "123-234". First find the
-// position of the dash, and then create one string view per limit value.
-
-long solve_group(const std::ranges::subrange<const char *>&& group) {
-    std::string_view group_sv = std::string_view(group);
-    size_t dash_pos = group_sv.find('-');
+// Parse and solve a single range string, e.g. "123-234", by splitting it at
+// the dash into one string view per limit value.
 
-    auto min_sv = group_sv.substr(0, dash_pos);
-    auto max_sv = group_sv.substr(dash_pos + 1);
+long solve_group(const std::string_view& group_sv) {
+    auto [min_sv, max_sv] = split_fields<2>(group_sv, '-');
     auto range = Range::parse(min_sv, max_sv);
 
     return solve_range(range);
 }
 
-// Split the ranges by commas, compute the sum of invalid IDs in each
-// range, and compute the sum of sums as the final answer.
+// Split the ranges by commas, compute the sum of invalid IDs in each range,
+// and compute the sum of sums as the final answer. Ranges are independent,
+// so we solve chunks of ranges in parallel on the shared thread pool.
+
+Solution solve(const std::vector<std::string_view>& lines, [[maybe_unused]] const std::string& input_name) {
+    const std::string_view& first_line = lines.front();
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    const std::string& first_line = lines.front();
+    auto groups = [&]() {
+        TRACE_SCOPE("parse");
+        return std::ranges::to<std::vector>(first_line
+            | std::views::split(',')
+            | std::views::transform([](auto&& group) { return std::string_view(group); }));
+    }();
 
-    auto results = std::string_view(first_line)
-        | std::views::split(',')
-        | std::views::transform(solve_group);
+    long total = parallel_reduce(0, groups.size(), RANGES_PER_CHUNK, 0L, [&](size_t begin, size_t end) {
+        auto chunk = std::span(groups).subspan(begin, end - begin);
+        return std::ranges::fold_left(chunk | std::views::transform(solve_group), 0L, std::plus{});
+    }, std::plus{});
 
-    long total = std::ranges::fold_left(results, 0, std::plus{});
-    
     return Solution { total };
 }
+
+} // namespace day02::part_b
+
+REGISTER_SOLUTION("02b", day02::part_b::solve);
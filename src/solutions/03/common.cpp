@@ -1,5 +1,9 @@
 #include "common.hpp"
 
+namespace day03 {
+
 int digit_to_int(char digit) {
     return digit - '0';
 }
+
+} // namespace day03
@@ -1,3 +1,7 @@
 #pragma once
 
+namespace day03 {
+
 int digit_to_int(char digit);
+
+} // namespace day03
@@ -0,0 +1,31 @@
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "../../generator.hpp"
+
+namespace day03 {
+
+// The real input contains 200 banks of 100 batteries each, i.e. 200 lines of
+// 100 digits from 1 to 9. We scale the number of banks.
+
+const size_t BASE_BANK_COUNT = 200;
+const size_t BANK_LENGTH = 100;
+
+bool generate(std::ostream& output, size_t scale, Random& random) {
+    std::string line = std::string(BANK_LENGTH, '0');
+
+    for (size_t index = 0; index < BASE_BANK_COUNT * scale; ++index) {
+        for (char& battery : line) {
+            battery = (char) ('0' + random.between(1, 9));
+        }
+
+        output << line << '\n';
+    }
+
+    return true;
+}
+
+} // namespace day03
+
+REGISTER_GENERATOR("03", day03::generate);
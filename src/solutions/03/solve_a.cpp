@@ -2,12 +2,21 @@
 #include <cstddef>
 #include <functional>
 #include <ranges>
-#include <string>
+#include <span>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
+#include "../../thread_pool.hpp"
 #include "common.hpp"
 
+namespace day03::part_a {
+
+// Minimum number of lines per chunk when solving lines in parallel. A line takes
+// about 0.4 μs, so a chunk does about 50 μs of work; the real input (200 lines)
+// is therefore solved on the calling thread.
+const size_t LINES_PER_CHUNK = 128;
+
 /*
     We first create two vectors, both with length equal to the length of the
     current line. One vector contains the maximum digit encountered thus far
@@ -29,7 +38,7 @@
     the solution slightly slower.
  */
 
-int solve_line(const std::string& line) {
+int solve_line(const std::string_view& line) {
     std::vector<char> max_digits_fw(line.length(), '0');
     std::vector<char> max_digits_bw(line.length(), '0');
 
@@ -58,7 +67,25 @@ int solve_line(const std::string& line) {
     return max_value;
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    int result = std::ranges::fold_left(lines | std::views::transform(solve_line), 0, std::plus{});
-    return Solution { result };
-}
+// Streaming state: the sum of the results of all lines consumed so far. Lines
+// are independent, so we solve chunks of every block of lines in parallel on the
+// shared thread pool, and add the results of all chunks to the total.
+
+struct Total {
+    int total = 0;
+
+    void consume(std::span<const std::string_view> lines) {
+        total += parallel_reduce(0, lines.size(), LINES_PER_CHUNK, (int) 0, [&](size_t begin, size_t end) {
+            auto chunk = lines.subspan(begin, end - begin);
+            return std::ranges::fold_left(chunk | std::views::transform(solve_line), (int) 0, std::plus{});
+        }, std::plus{});
+    }
+
+    Solution finish() const {
+        return Solution { total };
+    }
+};
+
+} // namespace day03::part_a
+
+REGISTER_STREAMING_SOLUTION("03a", day03::part_a::Total);
@@ -1,12 +1,22 @@
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <ranges>
-#include <string>
+#include <span>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
+#include "../../thread_pool.hpp"
 #include "common.hpp"
 
+namespace day03::part_b {
+
+// Minimum number of lines per chunk when solving lines in parallel. A line takes
+// about 3.5 μs, so a chunk does about 50 μs of work.
+const size_t LINES_PER_CHUNK = 16;
+
 /*
     While this sounds like a dynamic programming problem at first, there is
     never any reason to not be greedy, i.e. the highest value is constructed
@@ -72,7 +82,7 @@ Digit get_max_digit(std::vector<Digit>& digits_heap, size_t min_pos) {
 // selecting the highest available digit and updating the current position.
 // After every step, push the next tail digit onto the heap.
 
-long solve_line(const std::string& line) {
+long solve_line(const std::string_view& line) {
     std::vector<Digit> digits_heap = std::vector<Digit>(line.length() - TAIL_LENGTH);
     std::vector<Digit> digits_tail = std::vector<Digit>(TAIL_LENGTH);
 
@@ -105,7 +115,25 @@ long solve_line(const std::string& line) {
     return output_value;
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    long result = std::ranges::fold_left(lines | std::views::transform(solve_line), 0, std::plus{});
-    return Solution { result };
-}
+// Streaming state: the sum of the results of all lines consumed so far. Lines
+// are independent, so we solve chunks of every block of lines in parallel on the
+// shared thread pool, and add the results of all chunks to the total.
+
+struct Total {
+    long total = 0;
+
+    void consume(std::span<const std::string_view> lines) {
+        total += parallel_reduce(0, lines.size(), LINES_PER_CHUNK, (long) 0, [&](size_t begin, size_t end) {
+            auto chunk = lines.subspan(begin, end - begin);
+            return std::ranges::fold_left(chunk | std::views::transform(solve_line), (long) 0, std::plus{});
+        }, std::plus{});
+    }
+
+    Solution finish() const {
+        return Solution { total };
+    }
+};
+
+} // namespace day03::part_b
+
+REGISTER_STREAMING_SOLUTION("03b", day03::part_b::Total);
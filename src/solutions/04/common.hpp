@@ -1,7 +1,12 @@
 #pragma once
 
+#include <array>
+#include <memory_resource>
+#include <string_view>
 #include <vector>
 
+namespace day04 {
+
 struct Cell {
     bool is_roll;
     int neighbor_count;
@@ -16,8 +21,10 @@ struct Cell {
     }
 };
 
-std::vector<int> get_neighbor_offsets(int col_count);
+std::array<int, 8> get_neighbor_offsets(int col_count);
+
+void initialize_rolls(const std::vector<std::string_view>& lines, std::pmr::vector<Cell>& cells, int row_count, int col_count);
 
-void initialize_rolls(const std::vector<std::string>& lines, std::vector<Cell>& cells, int row_count, int col_count);
+void initialize_counts(std::pmr::vector<Cell>& cells, int row_count, int col_count);
 
-void initialize_counts(std::vector<Cell>& cells, int row_count, int col_count);
+} // namespace day04
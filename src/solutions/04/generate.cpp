@@ -0,0 +1,34 @@
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "../../generator.hpp"
+
+namespace day04 {
+
+// The real input is a square grid of 137 by 137 cells, about two thirds of which
+// contain a roll ('@'). We scale the number of cells, so the side of the grid
+// grows with the square root of the scale.
+
+const size_t BASE_GRID_SIZE = 137;
+const double ROLL_PROBABILITY = 0.65;
+
+bool generate(std::ostream& output, size_t scale, Random& random) {
+    size_t grid_size = (size_t) std::round((double) BASE_GRID_SIZE * std::sqrt((double) scale));
+    std::string line = std::string(grid_size, '.');
+
+    for (size_t row = 0; row < grid_size; ++row) {
+        for (char& cell : line) {
+            cell = random.chance(ROLL_PROBABILITY) ? '@' : '.';
+        }
+
+        output << line << '\n';
+    }
+
+    return true;
+}
+
+} // namespace day04
+
+REGISTER_GENERATOR("04", day04::generate);
@@ -1,10 +1,14 @@
 #include <algorithm>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
 #include "common.hpp"
 
+namespace day04::part_a {
+
 /*
     We create a grid vector consisting of cells, with each cell consisting of
     a boolean indicating whether the cell contains a roll, and an integer for
@@ -19,13 +23,20 @@
     neighbors of the grid cells without having to constantly check for indices
     that are outside of the grid, which simplifies the logic and allows us to
     use one-dimensional indices throughout.
+
+    The grid is allocated from the arena of the solve context, so that repeated
+    runs in profile mode do not have to allocate memory from the heap.
 */
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
+Solution solve(
+    const std::vector<std::string_view>& lines,
+    [[maybe_unused]] const std::string& input_name,
+    SolveContext& context
+) {
     int row_count = lines.size();
     int col_count = lines.front().length();
 
-    std::vector<Cell> cells = std::vector<Cell>((row_count + 2) * (col_count + 2));
+    std::pmr::vector<Cell> cells((row_count + 2) * (col_count + 2), context.arena());
     initialize_rolls(lines, cells, row_count, col_count);
     initialize_counts(cells, row_count, col_count);
 
@@ -33,3 +44,7 @@ Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std
 
     return Solution { total };
 }
+
+} // namespace day04::part_a
+
+REGISTER_SOLUTION("04a", day04::part_a::solve);
@@ -1,10 +1,15 @@
+#include <array>
 #include <cstddef>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
 #include "common.hpp"
 
+namespace day04::part_b {
+
 /*
     First initialize the cells like in the first part, then populate a queue
     with indices of cells that are already accessible. For each cell in this
@@ -18,19 +23,24 @@
     deque for the queue, but I found that a regular vector with an index to
     track processed elements is slightly faster. I also tried using a set,
     since a vector/deque-based queue will contain a substantial number of
-    duplicates, but this was slower than either alternative.
+    duplicates, but this was slower than either alternative. Both the grid and
+    the queue are allocated from the arena of the solve context.
 */
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
+Solution solve(
+    const std::vector<std::string_view>& lines,
+    [[maybe_unused]] const std::string& input_name,
+    SolveContext& context
+) {
     int row_count = lines.size();
     int col_count = lines.front().length();
 
-    std::vector<Cell> cells = std::vector<Cell>((row_count + 2) * (col_count + 2));
+    std::pmr::vector<Cell> cells((row_count + 2) * (col_count + 2), context.arena());
     initialize_rolls(lines, cells, row_count, col_count);
     initialize_counts(cells, row_count, col_count);
 
-    std::vector<int> neighbor_offsets = get_neighbor_offsets(col_count);
-    std::vector<size_t> remove_index_queue  = std::vector<size_t>();
+    std::array<int, 8> neighbor_offsets = get_neighbor_offsets(col_count);
+    std::pmr::vector<size_t> remove_index_queue(context.arena());
     remove_index_queue.reserve(cells.size());
     size_t queue_index = 0;
     int rolls_removed = 0;
@@ -71,3 +81,7 @@ Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std
 
     return Solution { rolls_removed };
 }
+
+} // namespace day04::part_b
+
+REGISTER_SOLUTION("04b", day04::part_b::solve);
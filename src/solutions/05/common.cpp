@@ -1,59 +1,44 @@
 #include "common.hpp"
 
-#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
 
-// Convert a string view to a long.
+#include "../../input_cache.hpp"
+#include "../../parsing.hpp"
+#include "../../solve_context.hpp"
+#include "../../trace.hpp"
 
-long string_view_to_long(const std::string_view& string_view) {
-    long result{};
+namespace day05 {
 
-    std::from_chars(string_view.data(), string_view.data() + string_view.size(), result);
-
-    return result;
-}
-
-// Parse the range lines, creating a start node and an end node for each line.
-// Stop when we encounter the empty line, and return the index of the line
-// after that, i.e. of the first ingredients line.
-
-size_t create_nodes_from_ranges(const std::vector<std::string>& lines, std::vector<Node>& nodes) {
-    size_t line_index = 0;
+// Parse the ingredient lines, adding ingredient nodes to the node vector.
 
+void create_nodes_from_ingredients(const std::vector<std::string_view>& lines, std::vector<Node>& nodes, size_t line_index) {
     for (; line_index < lines.size(); ++line_index) {
-        const std::string& line = lines[line_index];
+        long ingredient_id = parse_long(lines[line_index]);
+        nodes.push_back(Node { Node::NodeType::Ingredient, ingredient_id });
+    }
+}
 
-        if (line.empty()) {
-            return line_index + 1;
-        }
+// Load the range nodes and ingredient nodes from the binary input cache (see
+// 'input_cache.hpp'), which is shared by both parts. The input is only parsed
+// if the cache is missing or stale.
 
-        size_t dash_pos = lines[line_index].find('-');
-        std::string_view start_sv = std::string_view(line).substr(0, dash_pos);
-        std::string_view end_sv   = std::string_view(line).substr(dash_pos + 1);
-        long start_id = string_view_to_long(start_sv);
-        long end_id   = string_view_to_long(end_sv);
+CachedNodes load_nodes(const std::vector<std::string_view>& lines, const std::string& input_name, SolveContext& context) {
+    const std::string filename = get_cache_filename("05", input_name, "nodes");
 
-        nodes.push_back(Node { Node::NodeType::RangeStart, start_id });
-        nodes.push_back(Node { Node::NodeType::RangeEnd,   end_id   });
-    }
+    const CachedArrays& cached = context.cache.load<Node, Node>(filename, lines, [&](CacheBuilder& builder) {
+        TRACE_SCOPE("parse");
+        std::vector<Node> range_nodes = std::vector<Node>();
+        std::vector<Node> ingredient_nodes = std::vector<Node>();
+        size_t line_index = create_nodes_from_ranges(lines, range_nodes);
+        create_nodes_from_ingredients(lines, ingredient_nodes, line_index);
+        builder.add<Node>(range_nodes);
+        builder.add<Node>(ingredient_nodes);
+    });
 
-    return line_index;
+    return CachedNodes { cached.get<Node>(0), cached.get<Node>(1) };
 }
 
-// Comparator used to sort nodes, first by ID and then by type.
-
-bool compare_nodes(const Node& a, const Node& b) {
-    if (a.id == b.id) {
-        switch (a.node_type) {
-            case Node::NodeType::RangeStart:
-                return true;
-            
-            case Node::NodeType::Ingredient:
-                return b.node_type != Node::NodeType::RangeStart;
-            
-            case Node::NodeType::RangeEnd:
-                return false;
-        }
-    } else {
-        return a.id < b.id;
-    }
-}
+} // namespace day05
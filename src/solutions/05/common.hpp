@@ -1,8 +1,16 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
+#include "../../parsing.hpp"
+#include "../../solve_context.hpp"
+
+namespace day05 {
+
 struct Node {
     enum NodeType { RangeStart, RangeEnd, Ingredient };
 
@@ -10,8 +18,61 @@ struct Node {
     long id;
 };
 
-long string_view_to_long(const std::string_view& string_view);
+// Nodes of the input cache: one start and one end node per range, followed by
+// one node per ingredient in a separate array.
+
+struct CachedNodes {
+    std::span<const Node> range_nodes;
+    std::span<const Node> ingredient_nodes;
+};
+
+// Parse the range lines, creating a start node and an end node for each line.
+// Stop when we encounter the empty line, and return the index of the line
+// after that, i.e. of the first ingredients line. The parsing helpers are
+// constexpr, so that the second part can also solve the input at compile time
+// (see 'embedded.hpp').
+
+constexpr size_t create_nodes_from_ranges(const std::vector<std::string_view>& lines, std::vector<Node>& nodes) {
+    size_t line_index = 0;
+
+    for (; line_index < lines.size(); ++line_index) {
+        const std::string_view& line = lines[line_index];
+
+        if (line.empty()) {
+            return line_index + 1;
+        }
+
+        auto [start_id, end_id] = parse_fields<2>(line, '-');
+
+        nodes.push_back(Node { Node::NodeType::RangeStart, start_id });
+        nodes.push_back(Node { Node::NodeType::RangeEnd,   end_id   });
+    }
+
+    return line_index;
+}
+
+void create_nodes_from_ingredients(const std::vector<std::string_view>& lines, std::vector<Node>& nodes, size_t line_index);
+
+CachedNodes load_nodes(const std::vector<std::string_view>& lines, const std::string& input_name, SolveContext& context);
+
+// Comparator used to sort nodes, first by ID and then by type, with range start
+// nodes before ingredient nodes before range end nodes.
+
+constexpr bool compare_nodes(const Node& a, const Node& b) {
+    if (a.id == b.id) {
+        switch (a.node_type) {
+            case Node::NodeType::RangeStart:
+                return b.node_type != Node::NodeType::RangeStart;
+            
+            case Node::NodeType::Ingredient:
+                return b.node_type == Node::NodeType::RangeEnd;
+            
+            case Node::NodeType::RangeEnd:
+                return false;
+        }
+    }
 
-size_t create_nodes_from_ranges(const std::vector<std::string>& lines, std::vector<Node>& nodes);
+    return a.id < b.id;
+}
 
-bool compare_nodes(const Node& a, const Node& b);
+} // namespace day05
@@ -0,0 +1,35 @@
+#include <cstddef>
+#include <ostream>
+
+#include "../../generator.hpp"
+
+namespace day05 {
+
+// The real input contains about 180 (possibly overlapping) ranges of fresh IDs,
+// followed by an empty line and 1,000 ingredient IDs. IDs are up to about
+// 5 * 10^14, and ranges are up to about 5 * 10^11 IDs wide.
+
+const size_t BASE_RANGE_COUNT = 180;
+const size_t BASE_INGREDIENT_COUNT = 1000;
+const long MIN_ID = 1000000000000;
+const long MAX_ID = 500000000000000;
+const long MAX_RANGE_WIDTH = 500000000000;
+
+bool generate(std::ostream& output, size_t scale, Random& random) {
+    for (size_t index = 0; index < BASE_RANGE_COUNT * scale; ++index) {
+        long start = random.between(MIN_ID, MAX_ID);
+        output << start << '-' << start + random.between(0, MAX_RANGE_WIDTH) << '\n';
+    }
+
+    output << '\n';
+
+    for (size_t index = 0; index < BASE_INGREDIENT_COUNT * scale; ++index) {
+        output << random.between(MIN_ID, MAX_ID) << '\n';
+    }
+
+    return true;
+}
+
+} // namespace day05
+
+REGISTER_GENERATOR("05", day05::generate);
@@ -6,6 +6,8 @@
 #include "../../solution.hpp"
 #include "common.hpp"
 
+namespace day05::part_a {
+
 /*
     We first create a vector of nodes, which each represent either the start
     of a range, the end of a range, or an ingredient. Each node consists of a
@@ -22,19 +24,13 @@
     that are inside at least one range and are therefore fresh.
  */
 
- // Parse the ingredient lines, adding ingredient nodes to the node vector.
-
-void create_nodes_from_ingredients(const std::vector<std::string>& lines, std::vector<Node>& nodes, size_t line_index) {
-    for (; line_index < lines.size(); ++line_index) {
-        long ingredient_id = string_view_to_long(std::string_view(lines[line_index]));
-        nodes.push_back(Node { Node::NodeType::Ingredient, ingredient_id });
-    }
-}
+// The range nodes and ingredient nodes are loaded from the input cache, and
+// copied into a single vector of nodes, which we then sort.
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    std::vector<Node> nodes = std::vector<Node>();
-    size_t line_index = create_nodes_from_ranges(lines, nodes);
-    create_nodes_from_ingredients(lines, nodes, line_index);
+Solution solve(const std::vector<std::string_view>& lines, const std::string& input_name, SolveContext& context) {
+    CachedNodes cached_nodes = load_nodes(lines, input_name, context);
+    std::vector<Node> nodes = std::vector<Node>(cached_nodes.range_nodes.begin(), cached_nodes.range_nodes.end());
+    nodes.insert(nodes.end(), cached_nodes.ingredient_nodes.begin(), cached_nodes.ingredient_nodes.end());
     std::ranges::sort(nodes, compare_nodes);
     
     int count = 0;
@@ -58,3 +54,7 @@ Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std
     
     return Solution { count };
 }
+
+} // namespace day05::part_a
+
+REGISTER_SOLUTION("05a", day05::part_a::solve);
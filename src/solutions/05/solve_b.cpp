@@ -1,10 +1,15 @@
 #include <algorithm>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "../../embedded.hpp"
 #include "../../solution.hpp"
 #include "common.hpp"
 
+namespace day05::part_b {
+
 /*
     The rare Advent of Code challenge where the second part is both easier and
     faster than the first part. We use the same approach as in the first part,
@@ -19,9 +24,11 @@
     an O(N) iteration, and in this second part N is only in the order of ~400.
  */
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    std::vector<Node> nodes = std::vector<Node>();
-    create_nodes_from_ranges(lines, nodes);
+// Count the IDs covered by at least one range, given the start and end nodes of
+// all ranges. This is constexpr, so that it can also be used to solve the input
+// at compile time (see 'embedded.hpp').
+
+constexpr long count_fresh_ids(std::vector<Node> nodes) {
     std::ranges::sort(nodes, compare_nodes);
 
     long start = 0;
@@ -45,5 +52,31 @@ Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std
 
     }
 
-    return Solution { count };
+    return count;
 }
+
+// The range nodes are loaded from the input cache, and copied since we sort them.
+
+Solution solve(const std::vector<std::string_view>& lines, const std::string& input_name, SolveContext& context) {
+    CachedNodes cached_nodes = load_nodes(lines, input_name, context);
+    std::vector<Node> nodes = std::vector<Node>(cached_nodes.range_nodes.begin(), cached_nodes.range_nodes.end());
+    return Solution { count_fresh_ids(std::move(nodes)) };
+}
+
+// Solve an embedded input at compile time. The input cache is not available in
+// constant expressions, so we parse the range nodes directly.
+
+constexpr Solution solve_embedded_input(std::string_view input) {
+    std::vector<Node> nodes = std::vector<Node>();
+    create_nodes_from_ranges(split_embedded_lines(input), nodes);
+    return Solution { count_fresh_ids(std::move(nodes)) };
+}
+
+} // namespace day05::part_b
+
+REGISTER_SOLUTION("05b", day05::part_b::solve);
+
+#if defined(EMBED_INPUTS) && __has_include("input_05.hpp")
+#include "input_05.hpp"
+REGISTER_EMBEDDED_SOLUTION("05b", day05::part_b::solve_embedded_input(day05::EMBEDDED_INPUT));
+#endif
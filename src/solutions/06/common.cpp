@@ -1,21 +1,69 @@
 #include "common.hpp"
 
 #include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <ranges>
 #include <string>
+#include <string_view>
 #include <vector>
 
-bool is_space(const std::string& line, size_t index) {
+#include "../../thread_pool.hpp"
+
+namespace day06 {
+
+// Minimum number of indices per chunk when scanning for separators in parallel.
+// Checking an index takes about 0.01 μs, so the real input (about 3,800 indices)
+// is scanned on the calling thread.
+const size_t SEPARATOR_INDICES_PER_CHUNK = 8192;
+
+bool is_space(const std::string_view& line, size_t index) {
     return index >= line.length() || line[index] == ' ';
 }
 
-bool is_all_spaces(const std::vector<std::string>& lines, size_t index) {
+bool is_all_spaces(const std::vector<std::string_view>& lines, size_t index) {
     return std::ranges::find_if_not(lines, 
-            [&index](const std::string& line) -> bool 
+            [&index](const std::string_view& line) -> bool 
             { return is_space(line, index); } 
         ) == lines.end();
 }
 
-char get_operand_char(const std::string& line, size_t column_start) {
+// Find the start index of every column, i.e. the index directly after every
+// index at which all lines contain a space. We scan chunks of indices for
+// separators in parallel, and concatenate the results in chunk order. The
+// result ends with the start index of a virtual column one past the end of
+// the longest line, so column i covers [starts[i], starts[i + 1] - 1).
+
+std::vector<size_t> find_column_starts(const std::vector<std::string_view>& lines) {
+    auto get_length = std::views::transform([](const std::string_view& line) -> size_t { return line.length(); });
+    size_t max_length = std::ranges::max(lines | get_length);
+
+    std::vector<size_t> column_starts = parallel_reduce(0, max_length, SEPARATOR_INDICES_PER_CHUNK, std::vector<size_t>{},
+        [&](size_t begin, size_t end) {
+            std::vector<size_t> chunk_starts;
+
+            for (size_t index = begin; index < end; ++index) {
+                if (is_all_spaces(lines, index)) {
+                    chunk_starts.push_back(index + 1);
+                }
+            }
+
+            return chunk_starts;
+        },
+        [](std::vector<size_t> starts, const std::vector<size_t>& chunk_starts) {
+            starts.insert(starts.end(), chunk_starts.begin(), chunk_starts.end());
+            return starts;
+        }
+    );
+
+    column_starts.insert(column_starts.begin(), 0);
+    column_starts.push_back(max_length + 1);
+    return column_starts;
+}
+
+char get_operand_char(const std::string_view& line, size_t column_start) {
     size_t operand_pos = line.find_first_not_of(" ", column_start);
     return line[operand_pos];
 }
+
+} // namespace day06
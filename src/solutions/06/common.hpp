@@ -1,8 +1,19 @@
 #pragma once
 
-#include <string>
+#include <cstddef>
+#include <string_view>
 #include <vector>
 
-bool is_all_spaces(const std::vector<std::string>& lines, size_t index);
+namespace day06 {
 
-char get_operand_char(const std::string& line, size_t column_start);
+// Minimum number of columns (i.e. problems) per chunk when solving columns in
+// parallel. A column takes about 0.15 μs, so a chunk does about 40 μs of work.
+const size_t COLUMNS_PER_CHUNK = 256;
+
+bool is_all_spaces(const std::vector<std::string_view>& lines, size_t index);
+
+std::vector<size_t> find_column_starts(const std::vector<std::string_view>& lines);
+
+char get_operand_char(const std::string_view& line, size_t column_start);
+
+} // namespace day06
@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "../../generator.hpp"
+
+namespace day06 {
+
+// The real input contains about 1,000 problems, written as columns of four
+// numbers above an operator ('*' or '+'). Columns are separated by a column of
+// spaces, and numbers are either left-aligned or right-aligned within their
+// column. The real input has numbers of up to four digits; we use at most three
+// digits, so that the grand total of the larger inputs still fits in a long.
+
+const size_t BASE_PROBLEM_COUNT = 1000;
+const size_t NUMBER_COUNT = 4;
+const long MAX_DIGITS = 3;
+
+bool generate(std::ostream& output, size_t scale, Random& random) {
+    std::array<std::string, NUMBER_COUNT + 1> rows;
+
+    for (size_t problem = 0; problem < BASE_PROBLEM_COUNT * scale; ++problem) {
+        std::array<std::string, NUMBER_COUNT> numbers;
+        size_t width = 0;
+
+        for (std::string& number : numbers) {
+            long digits = random.between(1, MAX_DIGITS);
+            number = std::to_string(random.between(1, 9));
+
+            for (long digit = 1; digit < digits; ++digit) {
+                number += (char) ('0' + random.between(0, 9));
+            }
+
+            width = std::max(width, number.size());
+        }
+
+        bool left_aligned = random.chance(0.5);
+
+        for (size_t index = 0; index < NUMBER_COUNT; ++index) {
+            std::string padding = std::string(width - numbers[index].size(), ' ');
+            rows[index] += (problem > 0 ? " " : "");
+            rows[index] += left_aligned ? numbers[index] + padding : padding + numbers[index];
+        }
+
+        rows[NUMBER_COUNT] += (problem > 0 ? " " : "");
+        rows[NUMBER_COUNT] += (random.chance(0.5) ? '*' : '+') + std::string(width - 1, ' ');
+    }
+
+    for (const std::string& row : rows) {
+        output << row << '\n';
+    }
+
+    return true;
+}
+
+} // namespace day06
+
+REGISTER_GENERATOR("06", day06::generate);
@@ -1,14 +1,18 @@
 #include <algorithm>
 #include <charconv>
 #include <cstddef>
+#include <functional>
 #include <ranges>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
+#include "../../thread_pool.hpp"
 #include "common.hpp"
 
+namespace day06::part_a {
+
 /*
     This mostly just comes down to correctly parsing the input. We first search
     for the next index at which all lines contain a space, which gives us the
@@ -39,10 +43,10 @@ void trim_whitespace(std::string_view& sv) {
 
 // Create a string view for a column and parse the number in this view.
 
-long parse_number(const std::string& line, size_t column_start, size_t column_end) {
+long parse_number(const std::string_view& line, size_t column_start, size_t column_end) {
     long result{};
 
-    std::string_view sv = std::string_view(line).substr(column_start, column_end - column_start);
+    std::string_view sv = line.substr(column_start, column_end - column_start);
 
     trim_whitespace(sv);
 
@@ -53,10 +57,10 @@ long parse_number(const std::string& line, size_t column_start, size_t column_en
 
 // Solve a column, defined by its start index (inclusive) and end index (exclusive).
 
-long solve_column(const std::vector<std::string>& lines, size_t column_start, size_t column_end) {
+long solve_column(const std::vector<std::string_view>& lines, size_t column_start, size_t column_end) {
     std::vector<long> numbers = std::ranges::to<std::vector>(lines | 
         std::views::take(lines.size() - 1) | 
-        std::views::transform([&](const std::string& line) -> long 
+        std::views::transform([&](const std::string_view& line) -> long 
         { return parse_number(line, column_start, column_end); }
     ));
 
@@ -69,19 +73,25 @@ long solve_column(const std::vector<std::string>& lines, size_t column_start, si
     return std::ranges::fold_left(numbers | std::views::drop(1), numbers.front(), operand);
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    auto get_length = std::views::transform([](const std::string& line) -> size_t { return line.length(); });
-    size_t max_length = std::ranges::max(lines | get_length);
-    size_t column_start = 0;
-    long total = 0;
+// Columns are independent, so after finding the column boundaries, we solve
+// chunks of columns in parallel and sum up the results of all chunks.
+
+Solution solve(const std::vector<std::string_view>& lines, [[maybe_unused]] const std::string& input_name) {
+    std::vector<size_t> column_starts = find_column_starts(lines);
+
+    long total = parallel_reduce(0, column_starts.size() - 1, COLUMNS_PER_CHUNK, 0L, [&](size_t begin, size_t end) {
+        long chunk_total = 0;
 
-    for (size_t index = 0; index < max_length; ++index) {
-        if (is_all_spaces(lines, index)) {
-            total += solve_column(lines, column_start, index);
-            column_start = index + 1;
+        for (size_t column = begin; column < end; ++column) {
+            chunk_total += solve_column(lines, column_starts[column], column_starts[column + 1] - 1);
         }
-    }
 
-    total += solve_column(lines, column_start, max_length);
+        return chunk_total;
+    }, std::plus{});
+
     return Solution { total };
 }
+
+} // namespace day06::part_a
+
+REGISTER_SOLUTION("06a", day06::part_a::solve);
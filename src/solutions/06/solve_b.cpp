@@ -1,13 +1,17 @@
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <ranges>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
+#include "../../thread_pool.hpp"
 #include "common.hpp"
 
+namespace day06::part_b {
+
 /*
     Not that different from the first part. For each index of each column, we
     iterate backward through the first N-1 lines, and construct the number in
@@ -37,13 +41,13 @@ long parse_number(const std::vector<std::string_view>& number_svs, size_t column
     return value;
 }
 
-long solve_column(const std::vector<std::string>& lines, size_t column_start, size_t column_end) {
+long solve_column(const std::vector<std::string_view>& lines, size_t column_start, size_t column_end) {
     size_t column_width = column_end - column_start;
 
     auto number_svs = std::ranges::to<std::vector>(lines |
         std::views::take(lines.size() - 1) |
-        std::views::transform([&](const std::string& line) -> std::string_view { 
-            return std::string_view(line).substr(column_start, column_width); 
+        std::views::transform([&](const std::string_view& line) -> std::string_view { 
+            return line.substr(column_start, column_width); 
         })
     );
 
@@ -62,19 +66,25 @@ long solve_column(const std::vector<std::string>& lines, size_t column_start, si
     return std::ranges::fold_left(numbers | std::views::drop(1), numbers.front(), operand);
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    auto get_length = std::views::transform([](const std::string& line) -> size_t { return line.length(); });
-    size_t max_length = std::ranges::max(lines | get_length);
-    size_t column_start = 0;
-    long total = 0;
+// Columns are independent, so after finding the column boundaries, we solve
+// chunks of columns in parallel and sum up the results of all chunks.
+
+Solution solve(const std::vector<std::string_view>& lines, [[maybe_unused]] const std::string& input_name) {
+    std::vector<size_t> column_starts = find_column_starts(lines);
 
-    for (size_t index = 0; index < max_length; ++index) {
-        if (is_all_spaces(lines, index)) {
-            total += solve_column(lines, column_start, index);
-            column_start = index + 1;
+    long total = parallel_reduce(0, column_starts.size() - 1, COLUMNS_PER_CHUNK, 0L, [&](size_t begin, size_t end) {
+        long chunk_total = 0;
+
+        for (size_t column = begin; column < end; ++column) {
+            chunk_total += solve_column(lines, column_starts[column], column_starts[column + 1] - 1);
         }
-    }
 
-    total += solve_column(lines, column_start, max_length);
+        return chunk_total;
+    }, std::plus{});
+
     return Solution { total };
 }
+
+} // namespace day06::part_b
+
+REGISTER_SOLUTION("06b", day06::part_b::solve);
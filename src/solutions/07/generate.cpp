@@ -0,0 +1,51 @@
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "../../generator.hpp"
+
+namespace day07 {
+
+// The real input is a grid of 141 columns: a first row with the start ('S') in
+// the middle, followed by 70 pairs of an empty row and a row with splitters
+// ('^'). Splitters are never adjacent, and never at the edges of the grid.
+// We scale the number of cells, so both the width and the number of splitter
+// rows grow with the square root of the scale. The splitter density shrinks
+// by the same factor, so that the expected number of splits along a beam, and
+// therefore the number of timelines in the second part, stays the same.
+
+const size_t BASE_WIDTH = 141;
+const size_t BASE_SPLITTER_ROW_COUNT = 70;
+const double BASE_SPLITTER_PROBABILITY = 0.3;
+
+bool generate(std::ostream& output, size_t scale, Random& random) {
+    double factor = std::sqrt((double) scale);
+    size_t width = (size_t) std::round((double) BASE_WIDTH * factor) | 1;
+    size_t splitter_row_count = (size_t) std::round((double) BASE_SPLITTER_ROW_COUNT * factor);
+    double splitter_probability = BASE_SPLITTER_PROBABILITY / factor;
+
+    std::string empty_row = std::string(width, '.');
+    std::string row = empty_row;
+    row[width / 2] = 'S';
+    output << row << '\n';
+
+    for (size_t index = 0; index < splitter_row_count; ++index) {
+        output << empty_row << '\n';
+        row = empty_row;
+
+        for (size_t col = 2; col < width - 2; ++col) {
+            if (row[col - 1] != '^' && random.chance(splitter_probability)) {
+                row[col] = '^';
+            }
+        }
+
+        output << row << '\n';
+    }
+
+    return true;
+}
+
+} // namespace day07
+
+REGISTER_GENERATOR("07", day07::generate);
@@ -1,10 +1,14 @@
 #include <cstddef>
-#include <string>
+#include <span>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "../../embedded.hpp"
 #include "../../solution.hpp"
 
+namespace day07::part_a {
+
 /*
     Since beams can only travel downward, we can iterate through the input
     line by line while tracking the positions of the beams on the current
@@ -25,36 +29,53 @@
     line, although we do still need to reset the current vector to all false.
 */
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    size_t row_length = lines.front().size();
-    std::vector<bool> beams_a = std::vector<bool>(row_length, false);
-    std::vector<bool> beams_b = std::vector<bool>(row_length, false);
-    beams_a[lines.front().find('S')] = true;
-
-    std::vector<bool>* current_beams = &beams_a;
-    std::vector<bool>* next_beams    = &beams_b;
+// Streaming state: the beam positions on the last consumed row and the number
+// of splits so far. The first line initializes the beams at the start position;
+// every later line is processed as soon as it is consumed, so that only two rows
+// of beams are kept in memory, regardless of the number of lines.
 
+struct Beams {
+    std::vector<bool> current_beams;
+    std::vector<bool> next_beams;
     int nr_splits = 0;
 
-    for (size_t row_index = 1; row_index < lines.size(); ++row_index) {
-        const std::string& line = lines[row_index];
+    constexpr void consume(std::span<const std::string_view> lines) {
+        for (const std::string_view& line : lines) {
+            if (current_beams.empty()) {
+                current_beams = std::vector<bool>(line.size(), false);
+                next_beams = std::vector<bool>(line.size(), false);
+                current_beams[line.find('S')] = true;
+                continue;
+            }
 
-        next_beams->assign(next_beams->size(), false);
+            next_beams.assign(next_beams.size(), false);
 
-        for (size_t col_index = 0; col_index < row_length; ++col_index) {
-            if (current_beams->at(col_index)) {
-                if (line[col_index] == '^') {
-                    next_beams->at(col_index - 1) = true;
-                    next_beams->at(col_index + 1) = true;
-                    nr_splits++;
-                } else {
-                    next_beams->at(col_index) = true;
+            for (size_t col_index = 0; col_index < current_beams.size(); ++col_index) {
+                if (current_beams.at(col_index)) {
+                    if (line[col_index] == '^') {
+                        next_beams.at(col_index - 1) = true;
+                        next_beams.at(col_index + 1) = true;
+                        nr_splits++;
+                    } else {
+                        next_beams.at(col_index) = true;
+                    }
                 }
             }
+
+            std::swap(current_beams, next_beams);
         }
+    }
 
-        std::swap(current_beams, next_beams);
+    constexpr Solution finish() const {
+        return Solution { nr_splits };
     }
+};
+
+} // namespace day07::part_a
+
+REGISTER_STREAMING_SOLUTION("07a", day07::part_a::Beams);
 
-    return Solution { nr_splits };
-}
+#if defined(EMBED_INPUTS) && __has_include("input_07.hpp")
+#include "input_07.hpp"
+REGISTER_EMBEDDED_SOLUTION("07a", solve_embedded<day07::part_a::Beams>(day07::EMBEDDED_INPUT));
+#endif
@@ -1,10 +1,16 @@
 #include <algorithm>
+#include <cstddef>
 #include <functional>
-#include <string>
+#include <span>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "../../embedded.hpp"
 #include "../../solution.hpp"
 
+namespace day07::part_b {
+
 /*
     Very similar to the first part, but instead of a boolean indicating if
     the current index contains a beam, we use a long indicating in how many
@@ -16,37 +22,53 @@
     the sum of all timelines on the final row.
 */
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    size_t row_length = lines.front().size();
-    std::vector<long> timelines_a = std::vector<long>(row_length, 0);
-    std::vector<long> timelines_b = std::vector<long>(row_length, 0);
-    timelines_a[lines.front().find('S')] = 1;
+// Streaming state: the timeline counts on the last consumed row. As in the first
+// part, the first line initializes the counts, and every later line is processed
+// as soon as it is consumed, so that only two rows of counts are kept in memory.
 
-    std::vector<long>* current_timelines = &timelines_a;
-    std::vector<long>* next_timelines    = &timelines_b;
+struct Timelines {
+    std::vector<long> current_timelines;
+    std::vector<long> next_timelines;
 
-    for (size_t row_index = 1; row_index < lines.size(); ++row_index) {
-        const std::string& line = lines[row_index];
+    constexpr void consume(std::span<const std::string_view> lines) {
+        for (const std::string_view& line : lines) {
+            if (current_timelines.empty()) {
+                current_timelines = std::vector<long>(line.size(), 0);
+                next_timelines = std::vector<long>(line.size(), 0);
+                current_timelines[line.find('S')] = 1;
+                continue;
+            }
 
-        next_timelines->assign(next_timelines->size(), 0);
+            next_timelines.assign(next_timelines.size(), 0);
 
-        for (size_t col_index = 0; col_index < row_length; ++col_index) {
-            long current = current_timelines->at(col_index);
+            for (size_t col_index = 0; col_index < current_timelines.size(); ++col_index) {
+                long current = current_timelines.at(col_index);
 
-            if (current > 0) {
-                if (line[col_index] == '^') {
-                    next_timelines->at(col_index - 1) = next_timelines->at(col_index - 1) + current;
-                    next_timelines->at(col_index + 1) = next_timelines->at(col_index + 1) + current;
-                } else {
-                    next_timelines->at(col_index) = next_timelines->at(col_index) + current;
+                if (current > 0) {
+                    if (line[col_index] == '^') {
+                        next_timelines.at(col_index - 1) = next_timelines.at(col_index - 1) + current;
+                        next_timelines.at(col_index + 1) = next_timelines.at(col_index + 1) + current;
+                    } else {
+                        next_timelines.at(col_index) = next_timelines.at(col_index) + current;
+                    }
                 }
             }
+
+            std::swap(current_timelines, next_timelines);
         }
+    }
 
-        std::swap(current_timelines, next_timelines);
+    constexpr Solution finish() const {
+        long total = std::ranges::fold_left(current_timelines, 0, std::plus {});
+        return Solution { total };
     }
+};
+
+} // namespace day07::part_b
 
-    long total = std::ranges::fold_left(*current_timelines, 0, std::plus {});
+REGISTER_STREAMING_SOLUTION("07b", day07::part_b::Timelines);
 
-    return Solution { total };
-}
+#if defined(EMBED_INPUTS) && __has_include("input_07.hpp")
+#include "input_07.hpp"
+REGISTER_EMBEDDED_SOLUTION("07b", solve_embedded<day07::part_b::Timelines>(day07::EMBEDDED_INPUT));
+#endif
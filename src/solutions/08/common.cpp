@@ -1,20 +1,17 @@
 #include "common.hpp"
 
-#include <charconv>
 #include <cmath>
-#include <string_view>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
-// Parse a string view to a long.
-
-long string_view_to_long(const std::string_view& string_view) {
-    long result{};
+#include "../../input_cache.hpp"
+#include "../../parsing.hpp"
+#include "../../solve_context.hpp"
+#include "../../trace.hpp"
 
-    std::from_chars(string_view.data(), string_view.data() + string_view.size(), result);
-
-    return result;
-}
+namespace day08 {
 
 // Compute the square of the distance between two 3D points.
 
@@ -27,14 +24,11 @@ long compute_distance2(const Point& a, const Point& b) {
 
 // Parse a 3D point from a line by splitting it at the commas.
 
-void Point::parse(size_t index, const std::string& line) {
-    size_t comma_pos1 = line.find(',');
-    size_t comma_pos2 = line.find(',', comma_pos1 + 1);
-
-    std::string_view line_sv = std::string_view(line);
-    x = string_view_to_long(line_sv.substr(0, comma_pos1));
-    y = string_view_to_long(line_sv.substr(comma_pos1 + 1, comma_pos2 - comma_pos1 - 1));
-    z = string_view_to_long(line_sv.substr(comma_pos2 + 1));
+void Point::parse(size_t index, const std::string_view& line) {
+    auto [parsed_x, parsed_y, parsed_z] = parse_fields<3>(line, ',');
+    x = parsed_x;
+    y = parsed_y;
+    z = parsed_z;
     i = index;
 }
 
@@ -60,10 +54,33 @@ bool compare_edges(const Edge& a, const Edge& b) {
 
 // Parse input lines to a pre-created vector of points.
 
-void parse_points(const std::vector<std::string>& lines, std::vector<Point>& points) {
+void parse_points(const std::vector<std::string_view>& lines, std::span<Point> points) {
+    TRACE_SCOPE("parse");
+
     for (size_t index = 0; index < lines.size(); ++index) {
-        const std::string& line = lines[index];
+        const std::string_view& line = lines[index];
         points[index].parse(index, line);
     }
 }
 
+// Load the points from the binary input cache (see 'input_cache.hpp'), which is
+// shared by both parts. The input is only parsed if the cache is missing or stale.
+
+std::span<const Point> load_points(
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    SolveContext& context
+) {
+    TRACE_SCOPE("load points");
+    const std::string filename = get_cache_filename("08", input_name, "points");
+
+    const CachedArrays& cached = context.cache.load<Point>(filename, lines, [&](CacheBuilder& builder) {
+        std::vector<Point> points = std::vector<Point>(lines.size());
+        parse_points(lines, points);
+        builder.add<Point>(points);
+    });
+
+    return cached.get<Point>(0);
+}
+
+} // namespace day08
@@ -1,16 +1,26 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "../../solve_context.hpp"
+
+namespace day08 {
+
+// Minimum number of rows (first points of a pair) per chunk when processing
+// pairs of points in parallel.
+const size_t ROWS_PER_CHUNK = 8;
+
 struct Point {
     size_t i;
     long x;
     long y;
     long z;
 
-    void parse(size_t index, const std::string& line);
+    void parse(size_t index, const std::string_view& line);
 };
 
 struct Edge {
@@ -25,4 +35,12 @@ Edge create_edge(const Point& a, const Point& b);
 
 bool compare_edges(const Edge& a, const Edge& b);
 
-void parse_points(const std::vector<std::string>& lines, std::vector<Point>& points);
+void parse_points(const std::vector<std::string_view>& lines, std::span<Point> points);
+
+std::span<const Point> load_points(
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    SolveContext& context
+);
+
+} // namespace day08
@@ -0,0 +1,29 @@
+#include <cstddef>
+#include <ostream>
+
+#include "../../generator.hpp"
+
+namespace day08 {
+
+// The real input contains 1,000 junction boxes, i.e. 3D points with coordinates
+// between 0 and 99,999. We scale the number of points; note that the second
+// part needs memory for all N^2 / 2 edges of 24 bytes each, i.e. about 1.2 GB
+// at scale 10, which it sorts in place.
+
+const size_t BASE_POINT_COUNT = 1000;
+const long MAX_COORDINATE = 99999;
+
+bool generate(std::ostream& output, size_t scale, Random& random) {
+    for (size_t index = 0; index < BASE_POINT_COUNT * scale; ++index) {
+        long x = random.between(0, MAX_COORDINATE);
+        long y = random.between(0, MAX_COORDINATE);
+        long z = random.between(0, MAX_COORDINATE);
+        output << x << ',' << y << ',' << z << '\n';
+    }
+
+    return true;
+}
+
+} // namespace day08
+
+REGISTER_GENERATOR("08", day08::generate);
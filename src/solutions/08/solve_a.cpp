@@ -2,12 +2,18 @@
 #include <cstddef>
 #include <functional>
 #include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
+#include "../../thread_pool.hpp"
+#include "../../trace.hpp"
 #include "common.hpp"
 
+namespace day08::part_a {
+
 const size_t NR_CONNECTIONS_SAMPLE = 10;
 const size_t NR_CONNECTIONS_INPUT  = 1000;
 
@@ -54,19 +60,21 @@ const size_t NR_CONNECTIONS_INPUT  = 1000;
     Using this optimization, running time reduces from 35ms to less than 4ms.
  */
 
-// Find the top 1000 shortest edges. Start by adding the first 1000 edges to
-// the list, then sort it and store the maximum distance (squared to avoid
-// square root calculations). Only add the remaining edges to the list if
-// they are shorter than this maximum. After every 100 new edges, re-sort
-// the list and reduce it to the first 1000 entries again.
+// Find the top 1000 shortest edges among the pairs (i, j) with i in the range
+// [begin, end). Start by adding the first 1000 edges to the list, then sort it
+// and store the maximum distance (squared to avoid square root calculations).
+// Only add the remaining edges to the list if they are shorter than this
+// maximum. After every 100 new edges, re-sort the list and reduce it to the
+// first 1000 entries again.
 
-void initialize_edges(const std::vector<Point>& points, std::vector<Edge>& edges, size_t max_connections) {
+std::vector<Edge> find_top_edges(std::span<const Point> points, size_t begin, size_t end, size_t max_connections) {
+    std::vector<Edge> edges;
     edges.reserve(max_connections);
 
     size_t sort_margin = max_connections / 10;
     long max_distance2 = 0;
 
-    for (size_t i = 0; i < points.size(); ++i) {
+    for (size_t i = begin; i < end; ++i) {
         for (size_t j = i + 1; j < points.size(); ++j) {
             Edge edge = create_edge(points[i], points[j]);
 
@@ -90,6 +98,29 @@ void initialize_edges(const std::vector<Point>& points, std::vector<Edge>& edges
     }
 
     std::ranges::sort(edges, compare_edges);
+    edges.resize(std::min(edges.size(), max_connections));
+    return edges;
+}
+
+// Find the top 1000 shortest edges in parallel. Every chunk of rows keeps its
+// own top 1000 (with its own maximum distance), since the overall top 1000 is
+// always contained in the union of these lists. We then merge the sorted lists
+// of all chunks, and reduce the merged list to the first 1000 entries again.
+
+void initialize_edges(std::span<const Point> points, std::vector<Edge>& edges, size_t max_connections) {
+    TRACE_SCOPE("find top edges");
+
+    edges = parallel_reduce(0, points.size(), ROWS_PER_CHUNK, std::vector<Edge>{},
+        [&](size_t begin, size_t end) {
+            return find_top_edges(points, begin, end, max_connections);
+        },
+        [&](const std::vector<Edge>& edges_a, const std::vector<Edge>& edges_b) {
+            std::vector<Edge> merged = std::vector<Edge>(edges_a.size() + edges_b.size());
+            std::ranges::merge(edges_a, edges_b, merged.begin(), compare_edges);
+            merged.resize(std::min(merged.size(), max_connections));
+            return merged;
+        }
+    );
 }
 
 // Assign group IDs to points by connecting edges. We use an integer vector to
@@ -98,6 +129,7 @@ void initialize_edges(const std::vector<Point>& points, std::vector<Edge>& edges
 // group, add a point to an existing group, or merge two exsting groups.
 
 int find_point_groups(const std::vector<Edge>& edges, std::vector<int>& point_groups, size_t max_connections) {
+    TRACE_SCOPE("connect");
     int group_counter = 1;
 
     for (size_t connection_count = 0; connection_count < max_connections; ++connection_count) {
@@ -137,17 +169,17 @@ int find_point_groups(const std::vector<Edge>& edges, std::vector<int>& point_gr
 // before we can use the group ID as a group size vector index.
 
 void find_group_sizes(const std::vector<int>& point_groups, std::vector<int>& group_sizes) {
+    TRACE_SCOPE("group sizes");
     auto valid_group_ids = point_groups | std::views::filter([](int group_id) -> bool { return group_id > 0; });
     std::ranges::for_each(valid_group_ids, [&group_sizes](int group_id) { group_sizes[group_id - 1]++; });
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
+Solution solve(const std::vector<std::string_view>& lines, const std::string& input_name, SolveContext& context) {
     // The number of connections depends on whether we're processing the sample or the real input.
     size_t max_connections = (input_name == "sample") ? NR_CONNECTIONS_SAMPLE : NR_CONNECTIONS_INPUT;
 
-    // Step 1: Parse all lines to points.
-    std::vector<Point> points = std::vector<Point>(lines.size());
-    parse_points(lines, points);
+    // Step 1: Parse all lines to points, or load them from the input cache.
+    std::span<const Point> points = load_points(lines, input_name, context);
 
     // Step 2: Find the 1000 shortest edges.
     std::vector<Edge> edges = std::vector<Edge>();
@@ -162,8 +194,13 @@ Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std
     find_group_sizes(point_groups, group_sizes);
 
     // Step 5: Find the three largest groups.
+    TRACE_SCOPE("top three");
     std::ranges::sort(group_sizes, std::greater<>{});
     int result = group_sizes[0] * group_sizes[1] * group_sizes[2];
 
     return Solution { result };
 }
+
+} // namespace day08::part_a
+
+REGISTER_SOLUTION("08a", day08::part_a::solve);
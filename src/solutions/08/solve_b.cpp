@@ -1,10 +1,18 @@
 #include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
+#include "../../thread_pool.hpp"
+#include "../../trace.hpp"
 #include "common.hpp"
 
+namespace day08::part_b {
+
 /*
     For the second part, we do compute and sort all edges. It should be noted
     that we probably didn't have to; in practice, we only use the shortest 5000
@@ -27,26 +35,47 @@
     optimizations to the current approach (e.g. it should be possible to avoid
     the O(N) sweep when merging two groups), but the current solution runs in
     well under 100ms, and I've already spent enough time on this day.
+
+    With close to half a million edges for the given input, the edge vector is
+    by far the largest allocation of all solutions. It is therefore allocated
+    from the arena of the solve context (as are the groups), so that repeated
+    runs in profile mode do not pay for page faults on fresh memory. The points
+    are loaded from the binary input cache, which is shared with the first part.
 */
 
-// Create a sorted vector of all edges in the graph.
+// Fill the vector with all edges in the graph. The edges of row i (i.e. all
+// pairs (i, j) with j > i) start at a fixed index in the edge vector, so chunks
+// of rows can be initialized in parallel.
 
-void initialize_edges(const std::vector<Point>& points, std::vector<Edge>& edges) {
-    size_t edge_index = 0;
+void initialize_edges(std::span<const Point> points, std::pmr::vector<Edge>& edges) {
+    TRACE_SCOPE("initialize edges");
+    size_t point_count = points.size();
 
-    for (size_t i = 0; i < points.size(); ++i) {
-        for (size_t j = i + 1; j < points.size(); ++j) {
-            edges[edge_index++].initialize(points[i], points[j]);
+    parallel_for(0, point_count, ROWS_PER_CHUNK, [&](size_t begin, size_t end) {
+        size_t edge_index = (begin * (2 * point_count - begin - 1)) / 2;
+
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t j = i + 1; j < point_count; ++j) {
+                edges[edge_index++].initialize(points[i], points[j]);
+            }
         }
-    }
+    });
+}
+
+// Sort the edges in place using the parallel quicksort of the thread pool, which
+// needs no scratch buffer, so the edge vector remains the only allocation of its
+// size.
 
-    std::ranges::sort(edges, compare_edges);
+void sort_edges(std::pmr::vector<Edge>& edges) {
+    TRACE_SCOPE("sort edges");
+    parallel_sort(std::span(edges), compare_edges);
 }
 
 // Connect edges and create groups – using the same approach as in the first
 // part – until all points are part of one group, and return the last edge.
 
-const Edge& find_last_edge(const std::vector<Edge>& edges, std::vector<int>& point_groups) {
+const Edge& find_last_edge(const std::pmr::vector<Edge>& edges, std::pmr::vector<int>& point_groups) {
+    TRACE_SCOPE("connect");
     size_t unassigned_points = point_groups.size();
     size_t unique_group_count = 0;
     int group_counter = 1;
@@ -91,16 +120,20 @@ const Edge& find_last_edge(const std::vector<Edge>& edges, std::vector<int>& poi
     }
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    std::vector<Point> points = std::vector<Point>(lines.size());
-    parse_points(lines, points);
+Solution solve(
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    SolveContext& context
+) {
+    std::span<const Point> points = load_points(lines, input_name, context);
 
     size_t point_count = points.size();
     size_t edge_count = (point_count * (point_count - 1)) / 2;
-    std::vector<Edge> edges = std::vector<Edge>(edge_count);
+    std::pmr::vector<Edge> edges(edge_count, context.arena());
     initialize_edges(points, edges);
+    sort_edges(edges);
 
-    std::vector<int> point_groups = std::vector<int>(points.size(), 0);
+    std::pmr::vector<int> point_groups(points.size(), 0, context.arena());
     const Edge& last_edge = find_last_edge(edges, point_groups);
 
     const Point& last_point_a = points[last_edge.index_a];
@@ -108,3 +141,7 @@ Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std
 
     return Solution { last_point_a.x * last_point_b.x };
 }
+
+} // namespace day08::part_b
+
+REGISTER_SOLUTION("08b", day08::part_b::solve);
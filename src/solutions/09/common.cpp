@@ -1,37 +1,58 @@
 #include "common.hpp"
 
-#include <charconv>
+#include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 
-// Parse a string view to a long.
+#include "../../input_cache.hpp"
+#include "../../parsing.hpp"
+#include "../../solve_context.hpp"
+#include "../../trace.hpp"
 
-long string_view_to_long(const std::string_view& string_view) {
-    long result{};
-
-    std::from_chars(string_view.data(), string_view.data() + string_view.size(), result);
-
-    return result;
-}
+namespace day09 {
 
 // Parse a point from an input line by splitting at the comma.
 
-void Point::parse(const std::string& line) {
-    std::string_view sv = std::string_view(line);
-    size_t comma_pos = line.find(',');
-    x = string_view_to_long(sv.substr(0, comma_pos));
-    y = string_view_to_long(sv.substr(comma_pos + 1));
+void Point::parse(const std::string_view& line) {
+    auto [parsed_x, parsed_y] = parse_fields<2>(line, ',');
+    x = parsed_x;
+    y = parsed_y;
 }
 
 // Parse all points in the input lines.
 
-void parse_points(const std::vector<std::string>& lines, std::vector<Point>& points) {
+void parse_points(const std::vector<std::string_view>& lines, std::vector<Point>& points) {
+    TRACE_SCOPE("parse");
+
     for (size_t index = 0; index < lines.size(); ++index) {
         points[index].parse(lines[index]);
     }
 }
 
+// Load the points from the binary input cache (see 'input_cache.hpp'), which is
+// shared by both parts. The input is only parsed if the cache is missing or stale.
+
+std::span<const Point> load_points(
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    SolveContext& context
+) {
+    const std::string filename = get_cache_filename("09", input_name, "points");
+
+    const CachedArrays& cached = context.cache.load<Point>(filename, lines, [&](CacheBuilder& builder) {
+        std::vector<Point> points = std::vector<Point>(lines.size());
+        parse_points(lines, points);
+        builder.add<Point>(points);
+    });
+
+    return cached.get<Point>(0);
+}
+
 // Used to sort points by X value.
 
 bool compare_points(const Point& a, const Point& b) {
     return a.x <= b.x;
 }
+
+} // namespace day09
@@ -1,15 +1,29 @@
 #pragma once
 
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "../../solve_context.hpp"
+
+namespace day09 {
+
 struct Point {
     long x;
     long y;
 
-    void parse(const std::string& line);
+    void parse(const std::string_view& line);
 };
 
-void parse_points(const std::vector<std::string>& lines, std::vector<Point>& points);
+void parse_points(const std::vector<std::string_view>& lines, std::vector<Point>& points);
+
+std::span<const Point> load_points(
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    SolveContext& context
+);
 
 bool compare_points(const Point& a, const Point& b);
+
+} // namespace day09
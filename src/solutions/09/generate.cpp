@@ -0,0 +1,49 @@
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+
+#include "../../generator.hpp"
+
+namespace day09 {
+
+// The real input contains about 500 red tiles, which are the corners of a closed
+// rectilinear polygon: consecutive tiles (wrapping around) share either their
+// X or their Y coordinate, and edges alternate between horizontal and vertical.
+// We generate a histogram-shaped polygon, with bars of random heights at random
+// increasing X positions, starting and ending on the X axis. Coordinates of the
+// real input go up to 100,000; we scale this range with the number of tiles, up
+// to 10^9, so that tiles remain spread out and areas still fit in a long.
+
+const size_t BASE_BAR_COUNT = 250;
+const long BASE_COORDINATE_RANGE = 100000;
+const long MAX_COORDINATE_RANGE = 1000000000;
+
+bool generate(std::ostream& output, size_t scale, Random& random) {
+    size_t bar_count = BASE_BAR_COUNT * scale;
+    long coordinate_range = std::min(BASE_COORDINATE_RANGE * (long) scale, MAX_COORDINATE_RANGE);
+    long max_step = std::max(2L * coordinate_range / (long) bar_count, 1L);
+
+    long x = random.between(1, max_step);
+    long height = 0;
+    output << x << ",0\n";
+
+    for (size_t bar = 0; bar < bar_count; ++bar) {
+        long next_height = height;
+
+        while (next_height == height) {
+            next_height = random.between(1, coordinate_range);
+        }
+
+        height = next_height;
+        output << x << ',' << height << '\n';
+        x += random.between(1, max_step);
+        output << x << ',' << height << '\n';
+    }
+
+    output << x << ",0\n";
+    return true;
+}
+
+} // namespace day09
+
+REGISTER_GENERATOR("09", day09::generate);
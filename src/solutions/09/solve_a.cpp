@@ -1,12 +1,16 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdlib>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
 #include "common.hpp"
 
+namespace day09::part_a {
+
 /*
     We can of course easily compare all points to all other points, compute
     the areas of the corresponding rectangles, and keep track of the largest
@@ -79,9 +83,11 @@ void find_max_area(const std::vector<Point>& corners_a, const std::vector<Point>
     }
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    std::vector<Point> points = std::vector<Point>(lines.size());
-    parse_points(lines, points);
+// The points are loaded from the input cache, and copied since we sort them.
+
+Solution solve(const std::vector<std::string_view>& lines, const std::string& input_name, SolveContext& context) {
+    std::span<const Point> cached_points = load_points(lines, input_name, context);
+    std::vector<Point> points = std::vector<Point>(cached_points.begin(), cached_points.end());
 
     std::vector<Point> tl_corners { points.front() };
     std::vector<Point> bl_corners { points.front() };
@@ -99,3 +105,7 @@ Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std
     
     return Solution { max_area };
 }
+
+} // namespace day09::part_a
+
+REGISTER_SOLUTION("09a", day09::part_a::solve);
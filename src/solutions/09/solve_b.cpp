@@ -1,11 +1,21 @@
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
+#include "../../thread_pool.hpp"
 #include "common.hpp"
 
+namespace day09::part_b {
+
+// Minimum number of rows (first points of a pair) per chunk when checking
+// pairs of points in parallel.
+const size_t ROWS_PER_CHUNK = 8;
+
 /*
     We can intuitively say that a rectangle is invalid if it is crossed by any
     part of the border. For example, a rectangle from top left corner (0, 0) to
@@ -95,7 +105,7 @@ void initialize_ranges(const std::vector<Point>& points, std::vector<Range>& h_r
 // in the input vector. This function can be used both for horizontal
 // ranges (in which case A = Y and B = X) and vertical ones.
 
-bool no_crossing_ranges(std::vector<Range>& ranges, long min_a, long max_a, long min_b, long max_b) {
+bool no_crossing_ranges(const std::vector<Range>& ranges, long min_a, long max_a, long min_b, long max_b) {
     auto begin = std::ranges::lower_bound(ranges, Range { min_a, 0, 0 }, Range::compare);
     auto end   = std::ranges::upper_bound(ranges, Range { max_a, 0, 0 }, Range::compare);
 
@@ -106,7 +116,7 @@ bool no_crossing_ranges(std::vector<Range>& ranges, long min_a, long max_a, long
 
 // Check if a rectangle is valid by checking for crossing ranges.
 
-bool is_valid(const Point& a, const Point& b, std::vector<Range>& h_ranges, std::vector<Range>& v_ranges) {
+bool is_valid(const Point& a, const Point& b, const std::vector<Range>& h_ranges, const std::vector<Range>& v_ranges) {
     long max_x = std::max(a.x, b.x) - 1;
     long min_x = std::min(a.x, b.x) + 1;
     long max_y = std::max(a.y, b.y) - 1;
@@ -120,31 +130,43 @@ bool is_valid(const Point& a, const Point& b, std::vector<Range>& h_ranges, std:
 // opposite sides of the sorted points vector; this way, we more or less
 // move from larger to smaller rectangles, which allows us to quickly
 // discard later rectangles based on size alone.
-
-long find_max_area(const std::vector<Point>& points, std::vector<Range>& h_ranges, std::vector<Range>& v_ranges) {
-    long max_area = 0;
-
-    for (size_t i = 0; i < points.size(); ++i) {
-        const Point& point_a = points[i];
-
-        for (size_t j = points.size() - 1; j > i; --j) {
-            const Point& point_b = points[j];
-            long dx = std::abs(point_a.x - point_b.x) + 1;
-            long dy = std::abs(point_a.y - point_b.y) + 1;
-            long area = dx * dy;
-
-            if ((area > max_area) && is_valid(point_a, point_b, h_ranges, v_ranges)) {
-                max_area = area;
+//
+// Chunks of rows (i) are processed in parallel. All chunks share the largest
+// area found so far through an atomic, so that a valid rectangle found in one
+// chunk also lets the other chunks discard smaller rectangles early.
+
+long find_max_area(const std::vector<Point>& points, const std::vector<Range>& h_ranges, const std::vector<Range>& v_ranges) {
+    std::atomic<long> max_area = 0;
+
+    parallel_for(0, points.size(), ROWS_PER_CHUNK, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Point& point_a = points[i];
+
+            for (size_t j = points.size() - 1; j > i; --j) {
+                const Point& point_b = points[j];
+                long dx = std::abs(point_a.x - point_b.x) + 1;
+                long dy = std::abs(point_a.y - point_b.y) + 1;
+                long area = dx * dy;
+
+                if ((area > max_area.load(std::memory_order_relaxed)) && is_valid(point_a, point_b, h_ranges, v_ranges)) {
+                    long current_max = max_area.load(std::memory_order_relaxed);
+
+                    while (area > current_max && !max_area.compare_exchange_weak(current_max, area, std::memory_order_relaxed)) {
+                        // Retry until our area is stored, or another chunk stored a larger one.
+                    }
+                }
             }
         }
-    }
+    });
 
     return max_area;
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    std::vector<Point> points = std::vector<Point>(lines.size());
-    parse_points(lines, points);
+// The points are loaded from the input cache, and copied since we sort them.
+
+Solution solve(const std::vector<std::string_view>& lines, const std::string& input_name, SolveContext& context) {
+    std::span<const Point> cached_points = load_points(lines, input_name, context);
+    std::vector<Point> points = std::vector<Point>(cached_points.begin(), cached_points.end());
 
     std::vector<Range> h_ranges { };
     std::vector<Range> v_ranges { };
@@ -157,3 +179,7 @@ Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std
 
     return Solution { max_area };
 }
+
+} // namespace day09::part_b
+
+REGISTER_SOLUTION("09b", day09::part_b::solve);
@@ -1,10 +1,17 @@
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
 // #include "common.hpp"
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
+namespace day10::part_b {
+
+Solution solve(const std::vector<std::string_view>& lines, [[maybe_unused]] const std::string& input_name) {
     (void) lines;
     return Solution { -1 };
 }
+
+} // namespace day10::part_b
+
+REGISTER_SOLUTION("10b", day10::part_b::solve);
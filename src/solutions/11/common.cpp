@@ -1,15 +1,26 @@
 #include "common.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <map>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "../../input_cache.hpp"
+#include "../../solve_context.hpp"
+#include "../../trace.hpp"
+
+namespace day11 {
+
 // Return the index for the given label using the label_to_index map. If the
 // label is not yet in the map, add it with index value equal to the size of
 // the map, to ensure that indices increment starting from zero.
 
-size_t get_index(std::string label, std::map<std::string, size_t>& label_to_index) {
+size_t get_index(const std::string_view& label, LabelMap& label_to_index) {
     auto iter = label_to_index.find(label);
 
     if (iter != label_to_index.end()) {
@@ -17,7 +28,7 @@ size_t get_index(std::string label, std::map<std::string, size_t>& label_to_inde
     }
 
     size_t new_index = label_to_index.size();
-    label_to_index[label] = new_index;
+    label_to_index.emplace(label, new_index);
     return new_index;
 }
 
@@ -27,18 +38,65 @@ size_t get_index(std::string label, std::map<std::string, size_t>& label_to_inde
 // vector of vectors instead of a map of vectors, which speeds up lookup.
 
 void initialize(
-    const std::vector<std::string>& lines,
-    std::vector<std::vector<size_t>>& node_to_inputs,
-    std::map<std::string, size_t>& label_to_index
+    const std::vector<std::string_view>& lines,
+    NodeInputs& node_to_inputs,
+    LabelMap& label_to_index
 ) {
-    for (const std::string& line : lines) {
-        std::string source_label = line.substr(0, 3);
+    for (const std::string_view& line : lines) {
+        std::string_view source_label = line.substr(0, 3);
         size_t source_index = get_index(source_label, label_to_index);
         
         for (size_t start_pos = 5; start_pos < line.size(); start_pos += 4) {
-            std::string output_label = line.substr(start_pos, 3);
+            std::string_view output_label = line.substr(start_pos, 3);
             size_t output_index = get_index(output_label, label_to_index);
             node_to_inputs[output_index].push_back(source_index);
         }
     }
 }
+
+// Return the index of a special node, or SIZE_MAX if it is not in the input.
+
+size_t Graph::find_node(const std::string_view& label) const {
+    auto iter = std::ranges::find(SPECIAL_LABELS, label);
+    assert(iter != SPECIAL_LABELS.end() && "not a special label");
+    return special_nodes[iter - SPECIAL_LABELS.begin()];
+}
+
+// Load the graph from the binary input cache, which is shared by both parts. If
+// the cache is missing or stale, we parse the input as before (interning labels
+// in the label map, and collecting the inputs of every node in a vector), and
+// flatten the vectors of inputs into the offsets and inputs arrays.
+
+Graph load_graph(const std::vector<std::string_view>& lines, const std::string& input_name, SolveContext& context) {
+    const std::string filename = get_cache_filename("11", input_name, "graph");
+
+    const CachedArrays& cached = context.cache.load<size_t, size_t, size_t>(filename, lines, [&](CacheBuilder& builder) {
+        TRACE_SCOPE("parse");
+        NodeInputs node_to_inputs(lines.size() + 1, context.arena());
+        LabelMap label_to_index(context.arena());
+        initialize(lines, node_to_inputs, label_to_index);
+
+        std::vector<size_t> offsets = { 0 };
+        std::vector<size_t> inputs;
+
+        for (const std::pmr::vector<size_t>& node_inputs : node_to_inputs) {
+            inputs.insert(inputs.end(), node_inputs.begin(), node_inputs.end());
+            offsets.push_back(inputs.size());
+        }
+
+        std::vector<size_t> special_nodes;
+
+        for (const std::string_view& label : SPECIAL_LABELS) {
+            auto iter = label_to_index.find(label);
+            special_nodes.push_back((iter != label_to_index.end()) ? iter->second : SIZE_MAX);
+        }
+
+        builder.add<size_t>(offsets);
+        builder.add<size_t>(inputs);
+        builder.add<size_t>(special_nodes);
+    });
+
+    return Graph { cached.get<size_t>(0), cached.get<size_t>(1), cached.get<size_t>(2) };
+}
+
+} // namespace day11
@@ -1,14 +1,59 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <functional>
 #include <map>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
-size_t get_index(std::string label, std::map<std::string, size_t>& label_to_index);
+#include "../../solve_context.hpp"
+
+namespace day11 {
+
+// All containers are allocated from the arena of the solve context. The label map
+// uses a transparent comparator, so that we can look up labels by string view.
+
+typedef std::pmr::vector<std::pmr::vector<size_t>> NodeInputs;
+typedef std::pmr::map<std::pmr::string, size_t, std::less<>> LabelMap;
+
+size_t get_index(const std::string_view& label, LabelMap& label_to_index);
 
 void initialize(
-    const std::vector<std::string>& lines,
-    std::vector<std::vector<size_t>>& node_to_inputs,
-    std::map<std::string, size_t>& label_to_index
+    const std::vector<std::string_view>& lines,
+    NodeInputs& node_to_inputs,
+    LabelMap& label_to_index
 );
+
+// Labels of the nodes used by the solutions, in the order in which their indices
+// are stored in the input cache.
+const std::array<std::string_view, 5> SPECIAL_LABELS = { "out", "you", "svr", "dac", "fft" };
+
+// Graph in compressed sparse row (CSR) form, as stored in the binary input cache
+// (see 'input_cache.hpp'): the input nodes of node i are stored in `inputs`, from
+// index `offsets[i]` up to `offsets[i + 1]`. Labels are only interned when the
+// cache is built; the cache also stores the indices of the special nodes, which
+// are SIZE_MAX if their label does not occur in the input.
+
+struct Graph {
+    std::span<const size_t> offsets;
+    std::span<const size_t> inputs;
+    std::span<const size_t> special_nodes;
+
+    size_t size() const {
+        return offsets.size() - 1;
+    }
+
+    std::span<const size_t> get_inputs(size_t node) const {
+        return inputs.subspan(offsets[node], offsets[node + 1] - offsets[node]);
+    }
+
+    size_t find_node(const std::string_view& label) const;
+};
+
+Graph load_graph(const std::vector<std::string_view>& lines, const std::string& input_name, SolveContext& context);
+
+} // namespace day11
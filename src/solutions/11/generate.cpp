@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../../generator.hpp"
+
+namespace day11 {
+
+/*
+    The real input describes a directed acyclic graph of about 600 devices with
+    three-letter labels, each line listing a device and its outputs. The path
+    counts have a specific structure: there are a few hundred paths from 'you'
+    to 'out', and ~10^14 paths from 'svr' to 'out' that visit both 'dac' and
+    'fft', in that order. Random graphs either have far fewer paths, or far
+    more, which overflows the counters of the solutions; so we build the core
+    of the graph explicitly, as a chain of hubs where consecutive hubs are con-
+    nected through two or three parallel devices. The number of paths between
+    two hubs is then the product of the parallel device counts in between.
+
+    To scale the input, we add filler devices that feed into the core graph (or
+    into other filler devices further down), but that cannot be reached from
+    any of the starting devices. The solutions still visit these devices while
+    recursing from 'out', but the path counts stay the same. Since labels have
+    three letters, the graph can contain at most 26^3 devices, which limits the
+    scale to about 29.
+*/
+
+const size_t BASE_DEVICE_COUNT = 600;
+const size_t HUB_COUNT = 33;
+const size_t DAC_HUB = 10;
+const size_t FFT_HUB = 21;
+const size_t YOU_HUB = 27;
+const size_t MAX_FILLER_OUTPUT_DISTANCE = 50;
+
+// Get all three-letter labels except the reserved ones, in random order.
+
+std::vector<std::string> get_shuffled_labels(Random& random) {
+    std::vector<std::string> labels;
+
+    for (char a = 'a'; a <= 'z'; ++a) {
+        for (char b = 'a'; b <= 'z'; ++b) {
+            for (char c = 'a'; c <= 'z'; ++c) {
+                std::string label = { a, b, c };
+
+                if (label != "svr" && label != "you" && label != "dac" && label != "fft" && label != "out") {
+                    labels.push_back(label);
+                }
+            }
+        }
+    }
+
+    random.shuffle(labels);
+    return labels;
+}
+
+bool generate(std::ostream& output, size_t scale, Random& random) {
+    std::vector<std::string> labels = get_shuffled_labels(random);
+    size_t next_label = 0;
+
+    // Hubs; the first and last are 'svr' and 'out', respectively.
+    std::vector<std::string> hubs;
+
+    for (size_t hub = 0; hub < HUB_COUNT; ++hub) {
+        hubs.push_back(
+            hub == 0 ? "svr" :
+            hub == DAC_HUB ? "dac" :
+            hub == FFT_HUB ? "fft" :
+            hub == YOU_HUB ? "you" :
+            hub == HUB_COUNT - 1 ? "out" :
+            labels[next_label++]
+        );
+    }
+
+    // Core lines: each hub outputs to the parallel devices between it and the
+    // next hub, which in turn all output to that next hub. All core devices
+    // except 'svr' and 'you' can serve as outputs for filler devices.
+    std::vector<std::string> lines;
+    std::vector<std::string> filler_targets;
+
+    for (size_t hub = 0; hub + 1 < HUB_COUNT; ++hub) {
+        std::string hub_line = hubs[hub] + ":";
+        long parallel_count = random.between(2, 3);
+
+        for (long index = 0; index < parallel_count; ++index) {
+            const std::string& device = labels[next_label++];
+            hub_line += " " + device;
+            lines.push_back(device + ": " + hubs[hub + 1]);
+            filler_targets.push_back(device);
+        }
+
+        lines.push_back(hub_line);
+        filler_targets.push_back(hubs[hub + 1]);
+    }
+
+    size_t core_device_count = lines.size();
+    size_t filler_count = BASE_DEVICE_COUNT * scale - core_device_count;
+
+    if (next_label + filler_count > labels.size()) {
+        return false;
+    }
+
+    // Filler lines: each filler device outputs to one to three devices, either
+    // in the core graph or later filler devices, which keeps the graph acyclic.
+    size_t first_filler_label = next_label;
+
+    for (size_t filler = 0; filler < filler_count; ++filler) {
+        std::string line = labels[first_filler_label + filler] + ":";
+        long output_count = random.between(1, 3);
+
+        for (long index = 0; index < output_count; ++index) {
+            size_t remaining = filler_count - filler - 1;
+
+            if (remaining > 0 && random.chance(0.5)) {
+                size_t distance = random.between(1, std::min(remaining, MAX_FILLER_OUTPUT_DISTANCE));
+                line += " " + labels[first_filler_label + filler + distance];
+            } else {
+                line += " " + filler_targets[random.between(0, filler_targets.size() - 1)];
+            }
+        }
+
+        lines.push_back(line);
+    }
+
+    random.shuffle(lines);
+
+    for (const std::string& line : lines) {
+        output << line << '\n';
+    }
+
+    return true;
+}
+
+} // namespace day11
+
+REGISTER_GENERATOR("11", day11::generate);
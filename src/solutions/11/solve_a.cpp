@@ -1,11 +1,14 @@
 #include <cstddef>
-#include <map>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
 #include "common.hpp"
 
+namespace day11::part_a {
+
 /*
     We can use a recursive approach here. Let's say that nodes X and Y both
     have node Z as their output, and no other nodes output to Z. The number of
@@ -28,12 +31,14 @@
     recursive function call, we can immediately return this memoized result if
     it is available, which cuts out a ton of redundant calculations. Without
     memoization, this algorithm can take minutes or even hours; with memo-
-    ization, we finish in less than one millisecond.
+    ization, we finish in less than one millisecond. The graph is loaded from
+    the input cache in compressed sparse row form (see 'common.hpp'), and the
+    memoization vector is allocated from the arena of the solve context.
  */
 
 int recurse(
-    const std::vector<std::vector<size_t>>& node_to_inputs,
-    std::vector<int>& memo,
+    const Graph& graph,
+    std::pmr::vector<int>& memo,
     size_t current_node,
     size_t target_node
 ) {
@@ -45,24 +50,30 @@ int recurse(
 
     int nr_paths = 0;
 
-    for (size_t input_index : node_to_inputs[current_node]) {
-        nr_paths += recurse(node_to_inputs, memo, input_index, target_node);
+    for (size_t input_index : graph.get_inputs(current_node)) {
+        nr_paths += recurse(graph, memo, input_index, target_node);
     }
 
     memo[current_node] = nr_paths;
     return nr_paths;
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    std::vector<std::vector<size_t>> node_to_inputs { lines.size() + 1 };
-    std::vector<int> memo(node_to_inputs.size(), -1);
-    std::map<std::string, size_t> label_to_index {};
+Solution solve(
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    SolveContext& context
+) {
+    Graph graph = load_graph(lines, input_name, context);
+    std::pmr::vector<int> memo(graph.size(), -1, context.arena());
 
-    initialize(lines, node_to_inputs , label_to_index);
-    size_t out_node_index = label_to_index["out"];
-    size_t you_node_index = label_to_index["you"];
+    size_t out_node_index = graph.find_node("out");
+    size_t you_node_index = graph.find_node("you");
 
-    int nr_paths = recurse(node_to_inputs, memo, out_node_index, you_node_index);
+    int nr_paths = recurse(graph, memo, out_node_index, you_node_index);
 
     return Solution { nr_paths };
 }
+
+} // namespace day11::part_a
+
+REGISTER_SOLUTION("11a", day11::part_a::solve);
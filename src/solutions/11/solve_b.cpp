@@ -1,10 +1,14 @@
 #include <cstddef>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
 #include "common.hpp"
 
+namespace day11::part_b {
+
 /*
     We can reuse most of the approach of the first part by observing that we've
     got two possible routes consisting of three segments each:
@@ -31,12 +35,14 @@
     one, each of those six calls is 'lighter' than the one in the first part
     (since start and end nodes are closer together, and forbidden nodes give
     us more stopping conditions), so in practice this second part is only
-    slightly slower than the first part.
+    slightly slower than the first part. Like in the first part, the graph is
+    loaded from the input cache, and the memoization vectors are allocated from
+    the arena of the solve context.
   */
 
 long recurse(
-    const std::vector<std::vector<size_t>>& node_to_inputs,
-    std::vector<int>& memo,
+    const Graph& graph,
+    std::pmr::vector<int>& memo,
     size_t current_node,
     size_t target_node,
     size_t forbidden_node_a,
@@ -54,9 +60,9 @@ long recurse(
 
     long nr_paths = 0;
 
-    for (size_t input_index : node_to_inputs[current_node]) {
+    for (size_t input_index : graph.get_inputs(current_node)) {
         nr_paths += recurse(
-            node_to_inputs,
+            graph,
             memo,
             input_index,
             target_node,
@@ -70,16 +76,17 @@ long recurse(
 }
 
 long find_path_count(
-     const std::vector<std::vector<size_t>>& node_to_inputs,
+    const Graph& graph,
+    std::pmr::memory_resource* arena,
     size_t current_node,
     size_t target_node,
     size_t forbidden_node_a,
     size_t forbidden_node_b
 ) {
-    std::vector<int> memo(node_to_inputs.size(), -1);
+    std::pmr::vector<int> memo(graph.size(), -1, arena);
 
     return recurse(
-        node_to_inputs,
+        graph,
         memo,
         current_node,
         target_node,
@@ -88,25 +95,32 @@ long find_path_count(
     );
 }
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
-    std::vector<std::vector<size_t>> node_to_inputs { lines.size() + 1 };
-    std::map<std::string, size_t> label_to_index {};
+Solution solve(
+    const std::vector<std::string_view>& lines,
+    const std::string& input_name,
+    SolveContext& context
+) {
+    Graph graph = load_graph(lines, input_name, context);
+    std::pmr::memory_resource* arena = context.arena();
 
-    initialize(lines, node_to_inputs , label_to_index);
-    size_t out = label_to_index["out"];
-    size_t svr = label_to_index["svr"];
-    size_t dac = label_to_index["dac"];
-    size_t fft = label_to_index["fft"];
+    size_t out = graph.find_node("out");
+    size_t svr = graph.find_node("svr");
+    size_t dac = graph.find_node("dac");
+    size_t fft = graph.find_node("fft");
 
-    long nr_paths_svr_to_dac = find_path_count(node_to_inputs, dac, svr, out, fft);
-    long nr_paths_svr_to_fft = find_path_count(node_to_inputs, fft, svr, out, dac);
-    long nr_paths_dac_to_fft = find_path_count(node_to_inputs, fft, dac, out, svr);
-    long nr_paths_fft_to_dac = find_path_count(node_to_inputs, dac, fft, out, svr);
-    long nr_paths_dac_to_out = find_path_count(node_to_inputs, out, dac, fft, svr);
-    long nr_paths_fft_to_out = find_path_count(node_to_inputs, out, fft, dac, svr);
+    long nr_paths_svr_to_dac = find_path_count(graph, arena, dac, svr, out, fft);
+    long nr_paths_svr_to_fft = find_path_count(graph, arena, fft, svr, out, dac);
+    long nr_paths_dac_to_fft = find_path_count(graph, arena, fft, dac, out, svr);
+    long nr_paths_fft_to_dac = find_path_count(graph, arena, dac, fft, out, svr);
+    long nr_paths_dac_to_out = find_path_count(graph, arena, out, dac, fft, svr);
+    long nr_paths_fft_to_out = find_path_count(graph, arena, out, fft, dac, svr);
 
     long nr_paths_dac_fft = nr_paths_svr_to_dac * nr_paths_dac_to_fft * nr_paths_fft_to_out;
     long nr_paths_fft_dac = nr_paths_svr_to_fft * nr_paths_fft_to_dac * nr_paths_dac_to_out;
 
     return Solution { nr_paths_dac_fft + nr_paths_fft_dac };
-}
\ No newline at end of file
+}
+
+} // namespace day11::part_b
+
+REGISTER_SOLUTION("11b", day11::part_b::solve);
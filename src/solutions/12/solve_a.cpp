@@ -1,10 +1,17 @@
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../solution.hpp"
 // #include "common.hpp"
 
-Solution solve(const std::vector<std::string>& lines, [[maybe_unused]] const std::string& input_name) {
+namespace day12::part_a {
+
+Solution solve(const std::vector<std::string_view>& lines, [[maybe_unused]] const std::string& input_name) {
     (void) lines;
     return Solution { -1 };
 }
+
+} // namespace day12::part_a
+
+REGISTER_SOLUTION("12a", day12::part_a::solve);
@@ -0,0 +1,39 @@
+#include "solve_context.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+
+// Initial size of the arena buffer; grown on reset if a run needs more.
+const size_t INITIAL_ARENA_SIZE = 64 * 1024;
+
+void* CountingResource::do_allocate(size_t bytes, size_t alignment) {
+    bytes_allocated += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void CountingResource::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+}
+
+bool CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+SolveContext::SolveContext() : buffer(INITIAL_ARENA_SIZE) {
+    monotonic.emplace(buffer.data(), buffer.size(), &upstream);
+}
+
+// Release all memory of the previous run. If the previous run overflowed the
+// buffer, grow the buffer by the number of bytes taken from the heap, so that
+// the next run with the same allocation pattern fits into the buffer.
+
+void SolveContext::reset() {
+    monotonic.reset();
+
+    if (upstream.bytes_allocated > 0) {
+        buffer.resize(buffer.size() + upstream.bytes_allocated);
+        upstream.bytes_allocated = 0;
+    }
+
+    monotonic.emplace(buffer.data(), buffer.size(), &upstream);
+}
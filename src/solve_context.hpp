@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+#include "input_cache.hpp"
+
+// Memory resource that forwards to the default heap resource, and keeps track of
+// the total number of bytes it has handed out.
+
+struct CountingResource : std::pmr::memory_resource {
+    size_t bytes_allocated = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+// Optional context passed to solutions that opt in to it (see 'solution.hpp'). The
+// context owns an arena, i.e. a monotonic buffer resource: allocations are a
+// pointer bump, deallocations are no-ops, and all memory is released at once when
+// the harness calls `reset()` between runs. If a run needs more memory than the
+// arena's buffer holds, the overflow is taken from the heap, and the buffer is
+// grown by that amount on the next reset. After the first run, every following
+// run of the same solution is therefore served from the buffer without any
+// calls to malloc, which makes for more repeatable timings.
+//
+// The context also holds the binary input cache (see 'input_cache.hpp'), which
+// is not reset between runs, so that cached arrays are only loaded once.
+
+struct SolveContext {
+    std::vector<std::byte> buffer;
+    CountingResource upstream;
+    std::optional<std::pmr::monotonic_buffer_resource> monotonic;
+    InputCache cache;
+
+    SolveContext();
+
+    SolveContext(const SolveContext&) = delete;
+    SolveContext& operator=(const SolveContext&) = delete;
+
+    std::pmr::memory_resource* arena() {
+        return &monotonic.value();
+    }
+
+    void reset();
+};
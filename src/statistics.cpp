@@ -0,0 +1,225 @@
+#include "statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Samples with a modified z-score above this threshold are rejected as outliers.
+// The value of 3.5 is the conventional cut-off proposed by Iglewicz and Hoaglin.
+
+const double OUTLIER_THRESHOLD = 3.5;
+
+// Two-sided 95% critical values of Student's t-distribution for 1 to 30 degrees
+// of freedom; for larger sample sizes we use the normal approximation instead.
+
+const double T_CRITICAL_VALUES[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+     2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+     2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+
+double t_critical_value(size_t degrees_of_freedom) {
+    if (degrees_of_freedom == 0) {
+        return 0.0;
+    } else if (degrees_of_freedom <= 30) {
+        return T_CRITICAL_VALUES[degrees_of_freedom - 1];
+    }
+
+    return 1.960;
+}
+
+// Get a percentile from a sorted vector, linearly interpolating between the two
+// closest ranks; `fraction` is in the range [0, 1], e.g. 0.9 for the P90 value.
+
+double percentile(const std::vector<double>& sorted_samples, double fraction) {
+    if (sorted_samples.empty()) {
+        return 0.0;
+    }
+
+    double rank = fraction * (double) (sorted_samples.size() - 1);
+    size_t lower = (size_t) std::floor(rank);
+    size_t upper = (size_t) std::ceil(rank);
+    double weight = rank - (double) lower;
+
+    return sorted_samples[lower] + weight * (sorted_samples[upper] - sorted_samples[lower]);
+}
+
+// Remove outliers using the modified z-score, i.e. the distance to the median
+// in units of the median absolute deviation. Unlike a mean/stddev-based filter,
+// this is not skewed by the outliers themselves, which matters for timings,
+// where a single descheduled run can be orders of magnitude slower. If more
+// than half of the samples are identical the MAD is zero; in this case there
+// is no meaningful spread to compare against, and we keep all samples.
+
+std::vector<double> reject_outliers(const std::vector<double>& samples) {
+    std::vector<double> sorted = samples;
+    std::ranges::sort(sorted);
+    double median = percentile(sorted, 0.5);
+
+    std::vector<double> deviations = std::vector<double>(sorted.size());
+    std::ranges::transform(sorted, deviations.begin(), [median](double x) { return std::abs(x - median); });
+    std::ranges::sort(deviations);
+    double mad = percentile(deviations, 0.5);
+
+    if (mad == 0.0) {
+        return sorted;
+    }
+
+    std::vector<double> retained;
+    retained.reserve(sorted.size());
+
+    for (double sample : sorted) {
+        double modified_z_score = 0.6745 * std::abs(sample - median) / mad;
+
+        if (modified_z_score <= OUTLIER_THRESHOLD) {
+            retained.push_back(sample);
+        }
+    }
+
+    return retained;
+}
+
+Statistics Statistics::compute(const std::vector<double>& samples) {
+    std::vector<double> retained = reject_outliers(samples);
+    Statistics stats {};
+    stats.count = retained.size();
+    stats.outliers = samples.size() - retained.size();
+
+    if (retained.empty()) {
+        return stats;
+    }
+
+    double sum = 0.0;
+
+    for (double sample : retained) {
+        sum += sample;
+    }
+
+    stats.mean = sum / (double) stats.count;
+    double squared_error_sum = 0.0;
+
+    for (double sample : retained) {
+        squared_error_sum += (sample - stats.mean) * (sample - stats.mean);
+    }
+
+    stats.stddev = (stats.count > 1) ? std::sqrt(squared_error_sum / (double) (stats.count - 1)) : 0.0;
+
+    double margin = t_critical_value(stats.count - 1) * stats.stddev / std::sqrt((double) stats.count);
+    stats.ci_low  = stats.mean - margin;
+    stats.ci_high = stats.mean + margin;
+
+    // Order statistics are robust by themselves, and the tail is exactly what the
+    // percentiles should show, so they are computed over all samples.
+    std::vector<double> sorted = samples;
+    std::ranges::sort(sorted);
+    stats.min    = sorted.front();
+    stats.max    = sorted.back();
+    stats.median = percentile(sorted, 0.50);
+    stats.p90    = percentile(sorted, 0.90);
+    stats.p99    = percentile(sorted, 0.99);
+
+    return stats;
+}
+
+// One-sided Mann-Whitney U test of the hypothesis that samples in `current` tend
+// to be larger than those in `baseline`, returning the p-value. Unlike a t-test
+// on the means, this makes no assumptions about the shape of the distributions,
+// which for timings are typically skewed with a long tail. We use the normal
+// approximation of the U statistic, with a correction for ties and a contin-
+// uity correction, which is accurate enough from about ten samples per set.
+
+double mann_whitney_p_value(const std::vector<double>& baseline, const std::vector<double>& current) {
+    size_t n_baseline = baseline.size();
+    size_t n_current = current.size();
+    size_t n = n_baseline + n_current;
+
+    if (n_baseline == 0 || n_current == 0) {
+        return 1.0;
+    }
+
+    // Pairs of (value, is_current), sorted by value.
+    std::vector<std::pair<double, bool>> combined;
+    combined.reserve(n);
+
+    for (double sample : baseline) {
+        combined.emplace_back(sample, false);
+    }
+
+    for (double sample : current) {
+        combined.emplace_back(sample, true);
+    }
+
+    std::ranges::sort(combined);
+
+    // Assign ranks (starting at one), using the average rank for tied values,
+    // and sum the ranks of the current samples.
+    double current_rank_sum = 0.0;
+    double tie_term = 0.0;
+
+    for (size_t start = 0; start < n; ) {
+        size_t end = start;
+
+        while (end < n && combined[end].first == combined[start].first) {
+            end++;
+        }
+
+        double tie_count = (double) (end - start);
+        double average_rank = (double) (start + end + 1) / 2.0;
+        tie_term += tie_count * tie_count * tie_count - tie_count;
+
+        for (size_t index = start; index < end; ++index) {
+            if (combined[index].second) {
+                current_rank_sum += average_rank;
+            }
+        }
+
+        start = end;
+    }
+
+    double u = current_rank_sum - (double) (n_current * (n_current + 1)) / 2.0;
+    double u_mean = (double) (n_baseline * n_current) / 2.0;
+    double u_variance = (double) (n_baseline * n_current) / 12.0 *
+        ((double) (n + 1) - tie_term / (double) (n * (n - 1)));
+
+    if (u_variance <= 0.0) {
+        return 1.0;
+    }
+
+    double z = (u - u_mean - 0.5) / std::sqrt(u_variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+// Fit a power law `time = c * size^k` to measurements at different input sizes,
+// and return the exponent k, i.e. the empirical complexity (e.g. 1 for linear
+// and 2 for quadratic algorithms). This is a least-squares fit of a straight
+// line through the points in log-log space, whose slope is the exponent.
+
+double fit_power_law_exponent(const std::vector<double>& sizes, const std::vector<double>& times) {
+    size_t count = std::min(sizes.size(), times.size());
+
+    if (count < 2) {
+        return 0.0;
+    }
+
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+
+    for (size_t index = 0; index < count; ++index) {
+        mean_x += std::log(sizes[index]) / (double) count;
+        mean_y += std::log(times[index]) / (double) count;
+    }
+
+    double covariance = 0.0;
+    double variance = 0.0;
+
+    for (size_t index = 0; index < count; ++index) {
+        double dx = std::log(sizes[index]) - mean_x;
+        double dy = std::log(times[index]) - mean_y;
+        covariance += dx * dy;
+        variance += dx * dx;
+    }
+
+    return variance > 0.0 ? covariance / variance : 0.0;
+}
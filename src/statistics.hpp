@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Summary statistics over a set of timing samples. The minimum, maximum, median
+// and percentiles are computed over all samples, so that tail latency is never
+// hidden. The mean, standard deviation and confidence interval are computed after
+// rejecting outliers using the median absolute deviation (MAD), and `count` is
+// the number of retained samples. The confidence interval is the 95% interval of
+// the mean, based on Student's t-distribution.
+
+struct Statistics {
+    size_t count;
+    size_t outliers;
+    double min;
+    double max;
+    double mean;
+    double median;
+    double p90;
+    double p99;
+    double stddev;
+    double ci_low;
+    double ci_high;
+
+    static Statistics compute(const std::vector<double>& samples);
+};
+
+double percentile(const std::vector<double>& sorted_samples, double fraction);
+
+std::vector<double> reject_outliers(const std::vector<double>& samples);
+
+double mann_whitney_p_value(const std::vector<double>& baseline, const std::vector<double>& current);
+
+double fit_power_law_exponent(const std::vector<double>& sizes, const std::vector<double>& times);
@@ -0,0 +1,169 @@
+#include "stream.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "input.hpp"
+#include "sampler.hpp"
+
+// A block of input in the ring buffer shared between the reader and the consumer.
+// The reader fills free blocks in order, and marks them as full; the consumer
+// processes full blocks in the same order, and marks them as free again. The last
+// block is marked as such, so that the consumer knows when to stop.
+
+struct StreamBlock {
+    std::vector<char> data;
+    size_t size = 0;
+    bool is_full = false;
+    bool is_last = false;
+};
+
+struct BlockQueue {
+    std::vector<StreamBlock> blocks = std::vector<StreamBlock>(STREAM_BLOCK_COUNT);
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    // Wait until the block at the given index has the requested state.
+    StreamBlock& wait_for(size_t index, bool is_full) {
+        StreamBlock& block = blocks[index % blocks.size()];
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&]() { return block.is_full == is_full; });
+        return block;
+    }
+
+    void set_full(StreamBlock& block, bool is_full) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            block.is_full = is_full;
+        }
+
+        changed.notify_all();
+    }
+};
+
+// Read the file into consecutive blocks. Every block starts with the incomplete
+// last line of the previous block (the carry), followed by the next chunk of the
+// file, and is cut off after its last newline; the remainder becomes the next
+// carry. Blocks without any newline are not published, but are extended with the
+// next chunk instead. At the end of the file, the final carry (if any) becomes
+// the last line, as in `split_lines()`.
+//
+// Chunks are read with `pread()` at explicit offsets, in large sequential reads;
+// together with the sequential access advice given when opening the file (or
+// read-ahead on macOS, which has no `posix_fadvise()`), this lets the kernel read
+// ahead aggressively while the consumer is still computing.
+
+void read_blocks(int fd, BlockQueue& queue, double& read_us) {
+    register_sampler_thread();
+    std::string carry;
+    off_t offset = 0;
+
+    for (size_t index = 0; ; ++index) {
+        StreamBlock& block = queue.wait_for(index, false);
+        block.data.resize(carry.size() + STREAM_BLOCK_SIZE);
+        std::memcpy(block.data.data(), carry.data(), carry.size());
+        block.size = carry.size();
+        carry.clear();
+
+        while (true) {
+            auto start_time = std::chrono::steady_clock::now();
+            ssize_t read_count = pread(fd, block.data.data() + block.size, block.data.size() - block.size, offset);
+            auto end_time = std::chrono::steady_clock::now();
+            read_us += std::chrono::duration<double, std::micro>(end_time - start_time).count();
+            assert(read_count >= 0);
+            offset += read_count;
+
+            if (read_count == 0) {
+                block.is_last = true;
+                queue.set_full(block, true);
+                return;
+            }
+
+            block.size += read_count;
+            const char* block_begin = block.data.data();
+            const char* last_newline = find_last_newline(block_begin, block.size);
+
+            if (last_newline != nullptr) {
+                const char* block_end = last_newline + 1;
+                carry.assign(block_end, block_begin + block.size);
+                block.size = block_end - block_begin;
+                break;
+            }
+
+            if (block.size == block.data.size()) {
+                block.data.resize(block.size + STREAM_BLOCK_SIZE);
+            }
+        }
+
+        queue.set_full(block, true);
+    }
+}
+
+// Start the reader thread, and consume the blocks it produces on the calling thread.
+// Every block ends with a newline (except possibly the last one), so splitting it
+// with `split_lines()` yields exactly the lines it contains. The consumer tracks
+// how long it waits for blocks and how long it spends computing separately.
+
+StreamStats stream_lines(const std::string& filename, const LineConsumer& consume) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    assert(fd != -1);
+
+#if defined(__linux__)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#elif defined(__APPLE__)
+    fcntl(fd, F_RDAHEAD, 1);
+#endif
+
+    StreamStats stats { 0, 0, 0.0, 0.0, 0.0 };
+    BlockQueue queue;
+    std::thread reader(read_blocks, fd, std::ref(queue), std::ref(stats.read_us));
+
+    for (size_t index = 0; ; ++index) {
+        auto wait_time = std::chrono::steady_clock::now();
+        StreamBlock& block = queue.wait_for(index, true);
+        auto start_time = std::chrono::steady_clock::now();
+
+        std::vector<std::string_view> lines = split_lines(block.data.data(), block.size);
+        consume(lines);
+
+        auto end_time = std::chrono::steady_clock::now();
+        stats.wait_us += std::chrono::duration<double, std::micro>(start_time - wait_time).count();
+        stats.compute_us += std::chrono::duration<double, std::micro>(end_time - start_time).count();
+        stats.size += block.size;
+        stats.block_count++;
+
+        bool is_last = block.is_last;
+        queue.set_full(block, false);
+
+        if (is_last) {
+            break;
+        }
+    }
+
+    reader.join();
+    close(fd);
+    return stats;
+}
+
+// The kernel only drops clean pages, which is fine for input files that are only
+// read; pages that are mapped by other processes are not dropped either.
+
+void evict_file_cache([[maybe_unused]] const std::string& filename) {
+#if defined(__linux__)
+    int fd = open(filename.c_str(), O_RDONLY);
+    assert(fd != -1);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+#endif
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "solution.hpp"
+
+// Size of the blocks in which input files are streamed. Lines longer than a block
+// are carried over until they are complete, so blocks can grow beyond this size.
+const size_t STREAM_BLOCK_SIZE = 4 * 1024 * 1024;
+
+// Number of blocks in the ring buffer shared between the reader thread and the
+// consuming thread. The reader can run this many blocks ahead of the consumer,
+// which smooths out variations in both read latency and compute time per block.
+const size_t STREAM_BLOCK_COUNT = 4;
+
+// Timings of a stream, in microseconds. The reader thread spends `read_us` in read
+// calls, while the consuming thread spends `wait_us` waiting for the reader (i.e.
+// I/O wait) and `compute_us` splitting and consuming blocks. With full overlap, the
+// total time approaches the maximum of reading and computing instead of their sum.
+
+struct StreamStats {
+    size_t size;
+    size_t block_count;
+    double read_us;
+    double wait_us;
+    double compute_us;
+};
+
+// Stream the lines of a file to `consume()` in blocks of complete lines, using the
+// same line semantics as `split_lines()`.
+
+StreamStats stream_lines(const std::string& filename, const LineConsumer& consume);
+
+// Drop the cached pages of a file from the page cache, so that the next read
+// of the file has to go to the disk. This relies on `posix_fadvise()`, so it is
+// only supported on Linux; elsewhere, it does nothing.
+
+#if defined(__linux__)
+const bool FILE_CACHE_EVICTION_SUPPORTED = true;
+#else
+const bool FILE_CACHE_EVICTION_SUPPORTED = false;
+#endif
+
+void evict_file_cache(const std::string& filename);
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "sampler.hpp"
+
+// Work-stealing thread pool shared by all solutions (see `get_thread_pool()`), so
+// that solutions can process work in parallel without spawning threads on every
+// call. Every worker thread has its own task queue: it takes tasks from the back
+// of its own queue, and when that is empty, it steals tasks from the front of
+// the queues of other workers. Tasks submitted from outside the pool (e.g. from
+// the main thread) are distributed over the queues round-robin.
+//
+// The thread count includes the calling thread, which always processes part of
+// the work itself in `parallel_for()` and `parallel_reduce()`; a pool with one
+// thread therefore has no workers at all, and runs everything inline. Threads
+// waiting for their tasks to complete help process pending tasks in the mean-
+// time, so these functions can safely be nested. A waiting thread may thus run
+// unrelated tasks before it returns; callers that time individual work items
+// on every thread can prevent this with a `SerialScope` (see below).
+
+// Upper limit on the number of chunks per thread. Using a few chunks per thread
+// lets faster threads pick up more work when chunks take unequal time, e.g. for
+// the rows of a triangular pair loop, without adding too much overhead.
+
+const size_t CHUNKS_PER_THREAD = 4;
+
+struct ThreadPool {
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending_count = 0;
+    std::atomic<size_t> next_queue = 0;
+    std::atomic<bool> is_stopping = false;
+    std::mutex sleep_mutex;
+    std::condition_variable wake_condition;
+
+    explicit ThreadPool(size_t thread_count) {
+        start(thread_count);
+    }
+
+    ~ThreadPool() {
+        stop();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t thread_count() const {
+        return workers.size() + 1;
+    }
+
+    // Change the number of threads. Must not be called while tasks are running.
+    void resize(size_t thread_count) {
+        stop();
+        start(thread_count);
+    }
+
+    void submit(std::function<void()> task) {
+        size_t queue_index = get_worker_index();
+
+        if (queue_index >= queues.size()) {
+            queue_index = next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            pending_count.fetch_add(1, std::memory_order_release);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queues[queue_index]->mutex);
+            queues[queue_index]->tasks.push_back(std::move(task));
+        }
+
+        wake_condition.notify_one();
+    }
+
+    // Run a single pending task, taken from the queue of the current worker if
+    // possible, and stolen from another queue otherwise. Returns false if there
+    // were no pending tasks.
+    bool run_pending_task() {
+        std::function<void()> task;
+        size_t own_index = get_worker_index();
+
+        for (size_t offset = 0; offset < queues.size(); ++offset) {
+            size_t queue_index = (own_index < queues.size()) ? (own_index + offset) % queues.size() : offset;
+            TaskQueue& queue = *queues[queue_index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (queue.tasks.empty()) {
+                continue;
+            } else if (queue_index == own_index) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+
+            break;
+        }
+
+        if (!task) {
+            return false;
+        }
+
+        pending_count.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    // Index of the worker running on the current thread, or SIZE_MAX if the
+    // current thread is not a worker of this pool.
+    size_t get_worker_index() const {
+        return (current_pool() == this) ? current_worker_index() : SIZE_MAX;
+    }
+
+    static const ThreadPool*& current_pool() {
+        thread_local const ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    static size_t& current_worker_index() {
+        thread_local size_t worker_index = SIZE_MAX;
+        return worker_index;
+    }
+
+    // Whether parallel calls on the current thread must run inline (see `SerialScope`).
+    static bool& is_serial() {
+        thread_local bool serial = false;
+        return serial;
+    }
+
+    // Maximum number of chunks for a parallel call on the current thread.
+    size_t get_max_chunk_count() const {
+        return (thread_count() > 1 && !is_serial()) ? thread_count() * CHUNKS_PER_THREAD : 1;
+    }
+
+    // Number of chunks for `count` elements, such that every chunk has at least
+    // `grain_size` elements; ranges of fewer than two grains form a single chunk.
+    size_t get_chunk_count(size_t count, size_t grain_size) const {
+        return std::clamp(count / std::max(grain_size, (size_t) 1), (size_t) 1, get_max_chunk_count());
+    }
+
+    void start(size_t thread_count) {
+        size_t worker_count = std::max(thread_count, (size_t) 1) - 1;
+        is_stopping = false;
+        queues.clear();
+
+        for (size_t index = 0; index < std::max(worker_count, (size_t) 1); ++index) {
+            queues.push_back(std::make_unique<TaskQueue>());
+        }
+
+        for (size_t index = 0; index < worker_count; ++index) {
+            workers.emplace_back([this, index]() { run_worker(index); });
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            is_stopping = true;
+        }
+
+        wake_condition.notify_all();
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        workers.clear();
+    }
+
+    void run_worker(size_t index) {
+        register_sampler_thread();
+        current_pool() = this;
+        current_worker_index() = index;
+
+        while (true) {
+            if (run_pending_task()) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake_condition.wait(lock, [this]() { return is_stopping || pending_count.load(std::memory_order_acquire) > 0; });
+
+            if (is_stopping) {
+                return;
+            }
+        }
+    }
+};
+
+// Default number of threads: one per hardware thread.
+
+inline size_t get_default_thread_count() {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+inline ThreadPool& get_thread_pool() {
+    static ThreadPool pool(get_default_thread_count());
+    return pool;
+}
+
+// While a serial scope is alive, `parallel_for()`, `parallel_reduce()` and
+// `parallel_sort()` process all work inline on the thread that created it. This
+// is meant for threads that already run independent work items in parallel,
+// e.g. the inputs of a batch: a nested call never waits for its own tasks, so
+// it cannot pick up the tasks of another item while that item is being timed.
+
+struct SerialScope {
+    bool was_serial;
+
+    SerialScope() : was_serial(ThreadPool::is_serial()) {
+        ThreadPool::is_serial() = true;
+    }
+
+    ~SerialScope() {
+        ThreadPool::is_serial() = was_serial;
+    }
+
+    SerialScope(const SerialScope&) = delete;
+    SerialScope& operator=(const SerialScope&) = delete;
+};
+
+// Split the range [begin, end) into chunks of at least `grain_size` elements,
+// and call `function(chunk_begin, chunk_end)` for every chunk, spread over the
+// threads of the pool. Returns once all chunks have been processed. Ranges of
+// fewer than two grains are processed inline on the calling thread, so the grain
+// size should be large enough for a chunk to outweigh the cost of a task.
+
+template <typename Function>
+void parallel_for(size_t begin, size_t end, size_t grain_size, Function&& function) {
+    ThreadPool& pool = get_thread_pool();
+    size_t count = (end > begin) ? end - begin : 0;
+    size_t chunk_count = pool.get_chunk_count(count, grain_size);
+
+    if (chunk_count <= 1) {
+        if (count > 0) {
+            function(begin, end);
+        }
+
+        return;
+    }
+
+    auto get_chunk_begin = [=](size_t chunk) { return begin + (count * chunk) / chunk_count; };
+    std::atomic<size_t> remaining_count = chunk_count - 1;
+
+    for (size_t chunk = 1; chunk < chunk_count; ++chunk) {
+        pool.submit([&, chunk]() {
+            function(get_chunk_begin(chunk), get_chunk_begin(chunk + 1));
+            remaining_count.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    function(get_chunk_begin(0), get_chunk_begin(1));
+
+    while (remaining_count.load(std::memory_order_acquire) > 0) {
+        if (!pool.run_pending_task()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Compute `map(chunk_begin, chunk_end)` for every chunk of the range [begin, end)
+// in parallel, and fold the partial results into `initial` using `combine()`.
+// Partial results are combined in chunk order, so the result is deterministic
+// even if `combine()` is not commutative.
+
+template <typename T, typename Map, typename Combine>
+T parallel_reduce(size_t begin, size_t end, size_t grain_size, T initial, Map&& map, Combine&& combine) {
+    ThreadPool& pool = get_thread_pool();
+    size_t count = (end > begin) ? end - begin : 0;
+    size_t chunk_count = pool.get_chunk_count(count, grain_size);
+    std::vector<T> partials = std::vector<T>(chunk_count, initial);
+
+    parallel_for(0, chunk_count, 1, [&](size_t chunk_begin, size_t chunk_end) {
+        for (size_t chunk = chunk_begin; chunk < chunk_end; ++chunk) {
+            size_t range_begin = begin + (count * chunk) / chunk_count;
+            size_t range_end = begin + (count * (chunk + 1)) / chunk_count;
+
+            if (range_end > range_begin) {
+                partials[chunk] = map(range_begin, range_end);
+            }
+        }
+    });
+
+    T result = initial;
+
+    for (const T& partial : partials) {
+        result = combine(result, partial);
+    }
+
+    return result;
+}
+
+// Ranges smaller than this are sorted sequentially by `parallel_sort()`, since
+// the overhead of a task outweighs the work of partitioning them.
+
+const size_t PARALLEL_SORT_CUTOFF = 16384;
+
+// Sort `values` in parallel and in place, using quicksort: partition the range
+// around the median of its first, middle and last element into elements below,
+// equal to, and above the pivot, and sort the outer parts in parallel. Unlike a
+// merge sort, this needs no scratch buffer, so the peak memory use equals the
+// size of the input, which matters for the largest arrays (e.g. all edges of
+// day 08). Partitioning is sequential, so the critical path is about 2N element
+// moves, and the recursion only spawns tasks while there are idle threads left
+// to pick them up; deeper levels use `std::sort()`. Like `std::sort()`, this
+// sort is not stable.
+
+template <typename T, typename Compare>
+void parallel_sort(std::span<T> values, Compare compare, size_t depth) {
+    if (depth == 0 || values.size() < PARALLEL_SORT_CUTOFF) {
+        std::sort(values.begin(), values.end(), compare);
+        return;
+    }
+
+    const T& first = values.front();
+    const T& middle = values[values.size() / 2];
+    const T& last = values.back();
+    T pivot = compare(first, middle)
+        ? (compare(middle, last) ? middle : (compare(first, last) ? last : first))
+        : (compare(first, last) ? first : (compare(middle, last) ? last : middle));
+
+    auto lower_end = std::partition(values.begin(), values.end(), [&](const T& value) { return compare(value, pivot); });
+    auto upper_begin = std::partition(lower_end, values.end(), [&](const T& value) { return !compare(pivot, value); });
+    std::span<T> parts[2] = {
+        std::span<T>(values.begin(), lower_end),
+        std::span<T>(upper_begin, values.end())
+    };
+
+    parallel_for(0, 2, 1, [&](size_t part_begin, size_t part_end) {
+        for (size_t part = part_begin; part < part_end; ++part) {
+            parallel_sort(parts[part], compare, depth - 1);
+        }
+    });
+}
+
+// Allow a few more levels than needed to give every thread a task, so that
+// uneven partitions still leave enough tasks to balance the load.
+
+template <typename T, typename Compare>
+void parallel_sort(std::span<T> values, Compare compare) {
+    size_t depth = 0;
+
+    while (((size_t) 1 << depth) < get_thread_pool().thread_count()) {
+        depth++;
+    }
+
+    parallel_sort(values, compare, (get_thread_pool().get_max_chunk_count() > 1) ? depth + 3 : 0);
+}
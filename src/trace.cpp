@@ -0,0 +1,71 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "json.hpp"
+
+// Events recorded since the last call to `take_trace_events()`. Recording only
+// happens while tracing is enabled, so a mutex is cheap enough here.
+std::mutex trace_mutex;
+std::vector<TraceEvent> trace_events;
+
+// Counter used to assign a small index to every thread that records an event.
+std::atomic<size_t> trace_thread_counter = 0;
+
+int64_t trace_now_ns() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+size_t get_trace_thread_index() {
+    thread_local size_t thread_index = trace_thread_counter.fetch_add(1);
+    return thread_index;
+}
+
+void record_trace_event(const TraceEvent& event) {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    trace_events.push_back(event);
+}
+
+std::vector<TraceEvent> take_trace_events() {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    return std::exchange(trace_events, {});
+}
+
+// Write events in the Chrome trace event format, as complete ('X') events with
+// timestamps in microseconds, relative to the first event. The resulting file
+// can be opened in 'chrome://tracing' or 'https://ui.perfetto.dev'.
+
+void write_chrome_trace(const std::string& filename, const std::vector<TraceEvent>& events) {
+    int64_t origin_ns = events.empty() ? 0 : events.front().start_ns;
+
+    for (const TraceEvent& event : events) {
+        origin_ns = std::min(origin_ns, event.start_ns);
+    }
+
+    JsonValue json_events = JsonValue::make_array();
+
+    for (const TraceEvent& event : events) {
+        JsonValue json_event = JsonValue::make_object();
+        json_event.set("name", JsonValue::make_string(event.name));
+        json_event.set("ph", JsonValue::make_string("X"));
+        json_event.set("ts", JsonValue::make_number((double) (event.start_ns - origin_ns) / 1000.0));
+        json_event.set("dur", JsonValue::make_number((double) event.duration_ns / 1000.0));
+        json_event.set("pid", JsonValue::make_number(1));
+        json_event.set("tid", JsonValue::make_number((double) event.thread_index));
+        json_events.array.push_back(json_event);
+    }
+
+    JsonValue json = JsonValue::make_object();
+    json.set("traceEvents", json_events);
+    json.set("displayTimeUnit", JsonValue::make_string("ns"));
+    write_json_file(filename, json);
+}
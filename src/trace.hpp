@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Lightweight phase tracing for solutions. Wrap a phase of a solution in a scope
+// and mark it with `TRACE_SCOPE("name")`; the time spent in that scope is then
+// recorded as a trace event. Tracing has two switches:
+// - At compile time, `TRACE_SCOPE()` expands to nothing unless ENABLE_TRACE is
+//   defined (e.g. using `make profile 08a input TRACE=1`), so that solutions
+//   built normally do not pay anything for it.
+// - At run time, scopes only record events while tracing is enabled, which the
+//   profiler does for the timed runs only.
+// Events may be recorded from any thread. Names must be string literals, since
+// we only store the pointer.
+
+struct TraceEvent {
+    const char* name;
+    int64_t start_ns;
+    int64_t duration_ns;
+    size_t thread_index;
+};
+
+inline std::atomic<bool> tracing_enabled = false;
+
+inline bool is_tracing_enabled() {
+    return tracing_enabled.load(std::memory_order_relaxed);
+}
+
+inline void set_tracing_enabled(bool enabled) {
+    tracing_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+int64_t trace_now_ns();
+
+size_t get_trace_thread_index();
+
+void record_trace_event(const TraceEvent& event);
+
+std::vector<TraceEvent> take_trace_events();
+
+void write_chrome_trace(const std::string& filename, const std::vector<TraceEvent>& events);
+
+struct TraceScope {
+    const char* name;
+    int64_t start_ns;
+
+    explicit TraceScope(const char* name) : name(name), start_ns(is_tracing_enabled() ? trace_now_ns() : -1) {}
+
+    ~TraceScope() {
+        if (start_ns >= 0) {
+            record_trace_event(TraceEvent { name, start_ns, trace_now_ns() - start_ns, get_trace_thread_index() });
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a ## b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef ENABLE_TRACE
+#define TRACE_SCOPE(name) const TraceScope TRACE_CONCAT(trace_scope_, __LINE__) { name }
+const bool TRACE_SCOPES_COMPILED = true;
+#else
+#define TRACE_SCOPE(name) ((void) 0)
+const bool TRACE_SCOPES_COMPILED = false;
+#endif